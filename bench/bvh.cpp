@@ -0,0 +1,100 @@
+/**
+ * @file bvh.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bvh.h"
+#include "glm.hpp"
+#include "gtc/matrix_transform.hpp"
+#include "json.hpp"
+#include "timing.h"
+
+// Usage: bvh [primitives] [queries]. Scatters small boxes through a 1000 m cube and reports build and refit times and
+// the throughput of each query type.
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    const size_t queries = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 100000;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> position(0.0F, 1000.0F);
+    std::uniform_real_distribution<float> size(0.1F, 2.0F);
+    std::uniform_real_distribution<float> unit(-1.0F, 1.0F);
+    std::vector<serenity::Aabb> bounds(count);
+    for (auto& box : bounds) {
+        box.min = glm::vec3(position(random), position(random), position(random));
+        box.max = box.min + glm::vec3(size(random), size(random), size(random));
+    }
+
+    serenity::Bvh bvh;
+    nlohmann::json report;
+    report["primitives"] = count;
+    report["queries"] = queries;
+    report["build_ms"] = serenity::Time([&]() {
+        bvh.Build(bounds);
+    });
+    report["nodes"] = bvh.NodeCount();
+    report["sah_cost"] = bvh.Cost();
+
+    auto throughput = [queries](double milliseconds) {
+        return static_cast<double>(queries) / (milliseconds / 1000.0);
+    };
+    size_t hits = 0;
+    const auto raycast_ms = serenity::Time([&]() {
+        for (size_t i = 0; i < queries; ++i) {
+            const serenity::Ray ray{glm::vec3(position(random), position(random), position(random)), glm::normalize(glm::vec3(unit(random), unit(random), unit(random)) + glm::vec3(1e-4F))};
+            hits += bvh.Raycast(ray).Hit() ? 1 : 0;
+        }
+    });
+    report["raycasts_per_second"] = throughput(raycast_ms);
+    report["raycast_hit_rate"] = static_cast<double>(hits) / static_cast<double>(queries);
+
+    std::vector<uint32_t> found;
+    size_t overlaps = 0;
+    const auto overlap_ms = serenity::Time([&]() {
+        for (size_t i = 0; i < queries; ++i) {
+            found.clear();
+            const auto center = glm::vec3(position(random), position(random), position(random));
+            bvh.Overlap({center - glm::vec3(5.0F), center + glm::vec3(5.0F)}, found);
+            overlaps += found.size();
+        }
+    });
+    report["overlaps_per_second"] = throughput(overlap_ms);
+    report["overlap_mean_results"] = static_cast<double>(overlaps) / static_cast<double>(queries);
+
+    size_t nearby = 0;
+    const auto nearby_ms = serenity::Time([&]() {
+        for (size_t i = 0; i < queries; ++i) {
+            found.clear();
+            bvh.Nearby(glm::vec3(position(random), position(random), position(random)), 5.0F, found);
+            nearby += found.size();
+        }
+    });
+    report["nearby_per_second"] = throughput(nearby_ms);
+    report["nearby_mean_results"] = static_cast<double>(nearby) / static_cast<double>(queries);
+
+    const auto projection = glm::perspective(glm::radians(60.0F), 16.0F / 9.0F, 0.1F, 300.0F);
+    const auto view = glm::lookAt(glm::vec3(500.0F, 500.0F, -50.0F), glm::vec3(500.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+    const auto frustum = serenity::Frustum::FromViewProjection(projection * view);
+    found.clear();
+    report["cull_ms"] = serenity::Time([&]() {
+        bvh.Cull(frustum, found);
+    });
+    report["visible"] = found.size();
+
+    // Move a tenth of the boxes a short way, as a frame of animation would, and refit.
+    for (size_t i = 0; i < count; i += 10) {
+        const auto offset = glm::vec3(unit(random), unit(random), unit(random));
+        bvh.Update(static_cast<uint32_t>(i), {bounds[i].min + offset, bounds[i].max + offset});
+    }
+    report["refit_ms"] = serenity::Time([&]() {
+        bvh.Refit();
+    });
+    report["refit_degradation"] = bvh.Degradation();
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
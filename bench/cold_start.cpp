@@ -0,0 +1,35 @@
+/**
+ * @file cold_start.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "json.hpp"
+#include "serenity.h"
+
+int main() {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const auto begin = std::chrono::steady_clock::now();
+    auto app = std::make_unique<serenity::Serenity>();
+    const auto constructed = std::chrono::steady_clock::now();
+    app->Frame();
+    const auto first_frame = std::chrono::steady_clock::now();
+
+    nlohmann::json report;
+    report["startup_ms"] = Milliseconds(constructed - begin).count();
+    report["time_to_first_frame_ms"] = Milliseconds(first_frame - begin).count();
+    for (const auto& timing : app->StartupTimings()) {
+        report["stages"].push_back({
+            {"name", timing.name},
+            {"start_ms", Milliseconds(timing.start).count()},
+            {"duration_ms", Milliseconds(timing.duration).count()},
+            {"main_thread", timing.main_thread},
+        });
+    }
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
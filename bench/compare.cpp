@@ -0,0 +1,168 @@
+/**
+ * @file compare.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "json.hpp"
+#include "statistics.h"
+
+namespace {
+
+// CTest treats this exit code as a skipped test.
+constexpr int SKIPPED = 77;
+
+struct Thresholds {
+    double frame_time{5.0};
+    double startup{10.0};
+    double memory{5.0};
+    double alpha{0.01};
+};
+
+nlohmann::json Read(const std::filesystem::path& path) {
+    return nlohmann::json::parse(std::ifstream(path));
+}
+
+// Frames within a run are not independent samples, so each run contributes its own p95 and runs are compared.
+std::vector<double> FrameP95s(const std::vector<nlohmann::json>& runs) {
+    std::vector<double> values;
+    for (const auto& run : runs) {
+        values.push_back(serenity::Percentile(run["cpu_frame_ms"]["samples"].get<std::vector<double>>(), 95.0));
+    }
+    return values;
+}
+
+std::vector<double> Scalars(const std::vector<nlohmann::json>& runs, const std::string& key) {
+    std::vector<double> values;
+    for (const auto& run : runs) {
+        values.push_back(run[key].get<double>());
+    }
+    return values;
+}
+
+// Fewest runs per side for which the test can reach alpha at all: the p-value of a complete separation.
+size_t MinRuns(double alpha) {
+    constexpr size_t LIMIT = 64;
+    for (size_t runs = 2; runs < LIMIT; ++runs) {
+        std::vector<double> baseline(runs);
+        std::vector<double> candidate(runs);
+        for (size_t i = 0; i < runs; ++i) {
+            baseline[i] = static_cast<double>(i);
+            candidate[i] = static_cast<double>(runs + i);
+        }
+        if (serenity::MannWhitneyGreater(baseline, candidate) < alpha) {
+            return runs;
+        }
+    }
+    return LIMIT;
+}
+
+double Change(double baseline, double candidate) {
+    return baseline == 0.0 ? 0.0 : (candidate - baseline) / baseline * 100.0;
+}
+
+// A metric regresses when its point estimate moved past the threshold and the shift is unlikely to be noise.
+nlohmann::json Judge(const std::string& metric, double baseline, double candidate, double threshold, double p_value, double alpha) {
+    const auto change = Change(baseline, candidate);
+    return {
+        {"metric", metric},
+        {"baseline", baseline},
+        {"candidate", candidate},
+        {"change_percent", change},
+        {"threshold_percent", threshold},
+        {"p_value", p_value},
+        {"regressed", change > threshold && p_value < alpha},
+    };
+}
+
+}  // namespace
+
+// Usage: compare [options] <baseline> <report>...
+//        compare --record <baseline> <report>...
+// Compares benchmark reports from repeated runs against a baseline holding reports of its own, and exits 1 when p95
+// CPU frame time, startup time or peak memory regressed. A missing baseline skips the comparison. --record writes
+// the reports as the new baseline instead. Every metric is one value per run, the median of which is compared, and is
+// only judged with enough runs on each side for the test to reach alpha: five at the default 0.01. Options:
+// --frame-threshold, --startup-threshold, --memory-threshold (all percent) and --alpha.
+int main(int argc, char** argv) {
+    Thresholds thresholds;
+    bool record = false;
+    std::vector<std::string> paths;
+    for (int i = 1; i < argc; ++i) {
+        const std::string argument = argv[i];
+        auto value = [&]() {
+            if (i + 1 >= argc) {
+                std::cerr << argument << " needs a value" << std::endl;
+                std::exit(2);
+            }
+            return std::strtod(argv[++i], nullptr);
+        };
+        if (argument == "--record") {
+            record = true;
+        } else if (argument == "--frame-threshold") {
+            thresholds.frame_time = value();
+        } else if (argument == "--startup-threshold") {
+            thresholds.startup = value();
+        } else if (argument == "--memory-threshold") {
+            thresholds.memory = value();
+        } else if (argument == "--alpha") {
+            thresholds.alpha = value();
+        } else {
+            paths.push_back(argument);
+        }
+    }
+    if (paths.size() < 2) {
+        std::cerr << "usage: compare [--record] [options] <baseline> <report>..." << std::endl;
+        return 2;
+    }
+
+    std::vector<nlohmann::json> candidate;
+    for (size_t i = 1; i < paths.size(); ++i) {
+        candidate.push_back(Read(paths[i]));
+    }
+    if (record) {
+        std::ofstream(paths[0]) << nlohmann::json{{"runs", candidate}}.dump(4) << std::endl;
+        std::cout << "Recorded " << candidate.size() << " runs as " << paths[0] << std::endl;
+        return 0;
+    }
+    if (!std::filesystem::exists(paths[0])) {
+        std::cout << "No baseline at " << paths[0] << ", record one with --record" << std::endl;
+        return SKIPPED;
+    }
+    const std::vector<nlohmann::json> baseline = Read(paths[0])["runs"];
+
+    const auto min_runs = MinRuns(thresholds.alpha);
+    const auto sufficient = baseline.size() >= min_runs && candidate.size() >= min_runs;
+    nlohmann::json verdicts = nlohmann::json::array();
+    const std::tuple<const char*, std::vector<double>, std::vector<double>, double> metrics[] = {
+        {"p95_frame_ms", FrameP95s(baseline), FrameP95s(candidate), thresholds.frame_time},
+        {"startup_ms", Scalars(baseline, "startup_ms"), Scalars(candidate, "startup_ms"), thresholds.startup},
+        {"peak_rss_bytes", Scalars(baseline, "peak_rss_bytes"), Scalars(candidate, "peak_rss_bytes"), thresholds.memory},
+    };
+    for (const auto& [metric, baseline_values, candidate_values, threshold] : metrics) {
+        // With too few runs nothing can be significant, so the metric is reported but never fails.
+        const auto p = sufficient ? serenity::MannWhitneyGreater(baseline_values, candidate_values) : 1.0;
+        auto verdict = Judge(metric, serenity::Median(baseline_values), serenity::Median(candidate_values), threshold, p, thresholds.alpha);
+        if (!sufficient) {
+            verdict["p_value"] = nullptr;
+            verdict["note"] = "insufficient runs, need " + std::to_string(min_runs) + " on each side";
+        }
+        verdicts.push_back(std::move(verdict));
+    }
+
+    bool regressed = false;
+    for (const auto& verdict : verdicts) {
+        regressed = regressed || verdict["regressed"].get<bool>();
+    }
+    std::cout << nlohmann::json{{"baseline_runs", baseline.size()}, {"candidate_runs", candidate.size()}, {"regressed", regressed}, {"metrics", verdicts}}.dump(4) << std::endl;
+    return regressed ? 1 : 0;
+}
\ No newline at end of file
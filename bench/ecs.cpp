@@ -0,0 +1,128 @@
+/**
+ * @file ecs.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "ecs.h"
+#include "glm.hpp"
+#include "json.hpp"
+#include "timing.h"
+
+namespace {
+
+struct Position {
+    glm::vec3 value{0.0F};
+};
+
+struct Velocity {
+    glm::vec3 value{0.0F};
+};
+
+struct Health {
+    float value{100.0F};
+};
+
+// What the scene would look like without the ECS: one heap object per entity, visited through pointers.
+struct Object {
+    glm::vec3 position{0.0F};
+    glm::vec3 velocity{0.0F};
+    float health{100.0F};
+    char payload[64]{};
+};
+
+}  // namespace
+
+// Usage: ecs [entities]. Times entity creation, serial and parallel queries, component add/remove and destruction,
+// next to the same update over individually allocated objects.
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    constexpr float DELTA = 1.0F / 60.0F;
+    serenity::World world;
+    serenity::ThreadPool pool;
+    std::vector<serenity::Entity> entities;
+    entities.reserve(count);
+
+    nlohmann::json report;
+    report["entities"] = count;
+    report["threads"] = pool.Size() + 1;
+    report["create_ms"] = serenity::Time([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            entities.push_back(world.Create(Position{glm::vec3(static_cast<float>(i))}, Velocity{glm::vec3(1.0F, 0.0F, 0.0F)}));
+        }
+    });
+    report["query_ms"] = serenity::Time([&]() {
+        world.Each<Position, const Velocity>([](Position& position, const Velocity& velocity) {
+            position.value += velocity.value * DELTA;
+        });
+    });
+    report["query_chunked_ms"] = serenity::Time([&]() {
+        world.EachChunk<Position, const Velocity>([](size_t size, const serenity::Entity*, Position* positions, const Velocity* velocities) {
+            for (size_t i = 0; i < size; ++i) {
+                positions[i].value += velocities[i].value * DELTA;
+            }
+        });
+    });
+    report["query_parallel_ms"] = serenity::Time([&]() {
+        world.ParallelEach<Position, const Velocity>(pool, [](Position& position, const Velocity& velocity) {
+            position.value += velocity.value * DELTA;
+        });
+    });
+
+    serenity::SystemScheduler scheduler;
+    scheduler.Add<Position, const Velocity>("integrate", [](Position& position, const Velocity& velocity) {
+        position.value += velocity.value * DELTA;
+    });
+    scheduler.Add<Velocity>("damp", [](Velocity& velocity) {
+        velocity.value *= 0.99F;
+    });
+    scheduler.Add<Health>("regenerate", [](Health& health) {
+        health.value = std::min(health.value + DELTA, 100.0F);
+    });
+    report["scheduler_stages"] = scheduler.Stages();
+
+    const auto stride = std::max<size_t>(count / 100000, 1);
+    report["add_component_ms"] = serenity::Time([&]() {
+        for (size_t i = 0; i < count; i += stride) {
+            world.Add(entities[i], Health{});
+        }
+    });
+    report["scheduler_ms"] = serenity::Time([&]() {
+        scheduler.Run(world, pool);
+    });
+    report["remove_component_ms"] = serenity::Time([&]() {
+        for (size_t i = 0; i < count; i += stride) {
+            world.Remove<Health>(entities[i]);
+        }
+    });
+    report["components_changed"] = (count + stride - 1) / stride;
+    report["archetypes"] = world.ArchetypeCount();
+    report["destroy_ms"] = serenity::Time([&]() {
+        for (auto entity : entities) {
+            world.Destroy(entity);
+        }
+    });
+
+    // Shuffled allocation order stands in for a heap that has been churning for a while.
+    std::vector<std::unique_ptr<Object>> objects;
+    objects.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        objects.push_back(std::make_unique<Object>());
+        objects.back()->velocity = glm::vec3(1.0F, 0.0F, 0.0F);
+    }
+    std::shuffle(objects.begin(), objects.end(), std::mt19937(42));
+    report["pointer_chasing_query_ms"] = serenity::Time([&]() {
+        for (auto& object : objects) {
+            object->position += object->velocity * DELTA;
+        }
+    });
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
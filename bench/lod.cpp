@@ -0,0 +1,92 @@
+/**
+ * @file lod.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+#include "json.hpp"
+#include "lod_selector.h"
+#include "mesh.h"
+#include "mesh_simplifier.h"
+#include "timing.h"
+
+namespace {
+
+nlohmann::json Chain(const std::string& asset, const serenity::Mesh& mesh, serenity::LodChain& chain) {
+    nlohmann::json report;
+    report["asset"] = asset;
+    report["generate_ms"] = serenity::Time([&]() {
+        chain = serenity::GenerateLods(mesh);
+    });
+    for (const auto& level : chain.levels) {
+        report["levels"].push_back({{"triangles", level.index_count / 3}, {"error", level.error}});
+    }
+    return report;
+}
+
+// A camera dollies through a field of instances; counts level switches and the triangles drawn
+// relative to always drawing level 0.
+nlohmann::json Walk(const serenity::LodChain& chain, const serenity::LodSettings& settings) {
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> coordinate(-200.0F, 200.0F);
+    std::vector<glm::vec3> centers(10000);
+    for (auto& center : centers) {
+        center = glm::vec3(coordinate(random), 0.0F, coordinate(random) * 4.0F);
+    }
+    std::vector<serenity::LodState> states(centers.size());
+    serenity::LodSelector selector(settings);
+    constexpr uint32_t FRAMES = 600;
+    constexpr float DT = 1.0F / 60.0F;
+    // The unit sphere chain scaled up to a boulder.
+    constexpr float RADIUS = 20.0F;
+    uint64_t switches = 0;
+    uint64_t fading = 0;
+    double triangles = 0.0;
+    double full = 0.0;
+    const auto select_ms = serenity::Time([&]() {
+        for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+            // Small jitter on top of the dolly, like a hand-held camera.
+            const auto z = 600.0F * std::sin(static_cast<float>(frame) * 0.01F) + 4.0F * std::sin(static_cast<float>(frame) * 1.7F);
+            selector.SetView(glm::vec3(0.0F, 20.0F, z), glm::radians(60.0F), 1080.0F);
+            for (size_t i = 0; i < centers.size(); ++i) {
+                const auto before = states[i].level;
+                const auto selection = selector.Select(chain.levels, centers[i], RADIUS, RADIUS, states[i], DT);
+                switches += selection.level != before ? 1 : 0;
+                fading += selection.Fading() ? 1 : 0;
+                triangles += chain.levels[selection.level].index_count / 3;
+                if (selection.Fading()) {
+                    triangles += chain.levels[selection.previous].index_count / 3;
+                }
+                full += chain.levels[0].index_count / 3;
+            }
+        }
+    });
+    return {{"hysteresis", settings.hysteresis},
+            {"fade_time", settings.fade_time},
+            {"select_ns_per_instance", select_ms * 1e6 / static_cast<double>(FRAMES * centers.size())},
+            {"switches", switches},
+            {"fading_instance_frames", fading},
+            {"triangle_fraction", triangles / full}};
+}
+
+}  // namespace
+
+int main() {
+    nlohmann::json report;
+    serenity::LodChain sphere;
+    report["chains"].push_back(Chain("sphere", serenity::Mesh::Sphere(256, 512, 1.0F), sphere));
+    serenity::LodChain terrain;
+    report["chains"].push_back(Chain("terrain", serenity::Mesh::Terrain(256, 64.0F, 4.0F), terrain));
+    report["runtime"].push_back(Walk(sphere, {1.0F, 0.0F, 0.0F}));
+    report["runtime"].push_back(Walk(sphere, {1.0F, 0.25F, 0.0F}));
+    report["runtime"].push_back(Walk(sphere, {1.0F, 0.25F, 0.25F}));
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+/**
+ * @file orbit.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.h"
+#include "glm.hpp"
+#include "lod_selector.h"
+#include "serenity.h"
+
+// Usage: orbit [frames] [scene] [config] [report]. Set "headless" in the config to run without a window; the report
+// goes to stdout unless a path is given.
+int main(int argc, char** argv) {
+    serenity::BenchmarkOptions options;
+    options.name = "orbit";
+    options.frames = argc > 1 ? static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10)) : 1000;
+    options.scene = argc > 2 ? argv[2] : "bench/scenes/grid.json";
+    const std::filesystem::path config = argc > 3 ? argv[3] : "serenity.json";
+
+    auto app = std::make_unique<serenity::Serenity>(config);
+    serenity::Benchmark benchmark(*app, options);
+    // The renderer has no camera of its own; LOD selection is the view-dependent state, so the path drives it.
+    benchmark.SetFrameCallback([&app](const serenity::CameraPose& pose, uint32_t) {
+        app->Lods().SetView(pose.position, glm::radians(60.0F), 1080.0F);
+    });
+    const auto report = benchmark.Run();
+    if (argc > 4) {
+        std::ofstream(argv[4]) << report.dump(4) << std::endl;
+    } else {
+        std::cout << report.dump(4) << std::endl;
+    }
+    return 0;
+}
\ No newline at end of file
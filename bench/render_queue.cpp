@@ -0,0 +1,93 @@
+/**
+ * @file render_queue.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "json.hpp"
+#include "render_queue.h"
+#include "timing.h"
+
+namespace {
+
+nlohmann::json ToJson(const serenity::RenderQueueStats& stats) {
+    return {{"passes", stats.passes}, {"pipeline_binds", stats.pipeline_binds}, {"material_binds", stats.material_binds}};
+}
+
+}  // namespace
+
+// Usage: render_queue [repeats]. Sorts queues of 100k to 1M draws spread over 4 passes, 64 pipelines and 32
+// materials per pipeline with the radix sort, std::sort and std::stable_sort, and reports the state changes recording
+// the queue would cost in submission order and in sorted order.
+int main(int argc, char** argv) {
+    const size_t repeats = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 5;
+    serenity::ThreadPool pool;
+    nlohmann::json report;
+    report["threads"] = pool.Size() + 1;
+    report["repeats"] = repeats;
+
+    for (const size_t count : {100000, 300000, 1000000}) {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<uint32_t> pass(0, 3);
+        std::uniform_int_distribution<uint32_t> pipeline(0, 63);
+        std::uniform_int_distribution<uint32_t> material(0, 31);
+        std::uniform_real_distribution<float> depth(0.1F, 500.0F);
+        std::vector<serenity::DrawItem> items(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            const auto pipeline_index = pipeline(random);
+            const serenity::DrawKey key{pass(random), pipeline_index, pipeline_index * 32 + material(random), serenity::DrawKey::DepthBucket(depth(random), 0.1F, 500.0F)};
+            items[i] = {key.Pack(), i};
+        }
+
+        serenity::RenderQueue queue;
+        double radix_ms = 0.0;
+        double std_sort_ms = 0.0;
+        double stable_sort_ms = 0.0;
+        std::vector<serenity::DrawItem> sorted;
+        for (size_t repeat = 0; repeat < repeats; ++repeat) {
+            queue.Clear();
+            queue.Append(items);
+            radix_ms += serenity::Time([&]() {
+                queue.Sort(pool);
+            });
+            sorted = items;
+            std_sort_ms += serenity::Time([&]() {
+                std::sort(sorted.begin(), sorted.end(), [](const serenity::DrawItem& a, const serenity::DrawItem& b) {
+                    return a.key < b.key;
+                });
+            });
+            sorted = items;
+            stable_sort_ms += serenity::Time([&]() {
+                std::stable_sort(sorted.begin(), sorted.end(), [](const serenity::DrawItem& a, const serenity::DrawItem& b) {
+                    return a.key < b.key;
+                });
+            });
+        }
+        const auto matches = std::equal(sorted.begin(), sorted.end(), queue.Items().begin(), queue.Items().end(), [](const serenity::DrawItem& a, const serenity::DrawItem& b) {
+            return a.key == b.key && a.draw == b.draw;
+        });
+        if (!matches) {
+            std::cerr << "Radix sort disagrees with std::stable_sort at " << count << " items." << std::endl;
+            return 1;
+        }
+
+        serenity::RenderQueue unsorted;
+        unsorted.Append(items);
+        nlohmann::json run;
+        run["items"] = count;
+        run["radix_sort_ms"] = radix_ms / static_cast<double>(repeats);
+        run["std_sort_ms"] = std_sort_ms / static_cast<double>(repeats);
+        run["std_stable_sort_ms"] = stable_sort_ms / static_cast<double>(repeats);
+        run["unsorted"] = ToJson(unsorted.Stats());
+        run["sorted"] = ToJson(queue.Stats());
+        report["runs"].push_back(run);
+    }
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
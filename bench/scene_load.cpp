@@ -0,0 +1,69 @@
+/**
+ * @file scene_load.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include "json.hpp"
+#include "process_stats.h"
+#include "scene_loader.h"
+
+// Usage: scene_load [megabytes] [path]. Generates a synthetic scene of roughly the requested size, then loads it
+// with the streaming loader and with a DOM parse. The streaming load runs first because peak RSS never goes down.
+int main(int argc, char** argv) {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    const uint64_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+    const std::filesystem::path path = argc > 2 ? argv[2] : "scene_load.json";
+
+    {
+        std::ofstream file(path);
+        file << "{\"assets\": [{\"id\": \"tree\", \"path\": \"meshes/tree.mesh\", \"type\": \"mesh\"}],\n\"entities\": [\n";
+        uint64_t written = 0;
+        for (uint64_t i = 0; written < megabytes * 1024 * 1024; ++i) {
+            const auto entity = nlohmann::json{
+                {"name", "entity_" + std::to_string(i)},
+                {"mesh", "tree"},
+                {"material", "bark"},
+                {"position", {static_cast<double>(i % 1000), 0.0, static_cast<double>(i / 1000)}},
+                {"rotation", {0.0, 0.0, 0.0, 1.0}},
+                {"scale", {1.0, 1.0, 1.0}},
+                {"parent", i == 0 ? -1 : static_cast<int64_t>((i - 1) / 4)},
+            }.dump();
+            file << (i == 0 ? "" : ",\n") << entity;
+            written += entity.size() + 2;
+        }
+        file << "\n]}\n";
+    }
+    const auto file_size = std::filesystem::file_size(path);
+    const auto baseline_rss = serenity::PeakResidentBytes();
+
+    uint64_t checksum = 0;
+    serenity::SceneLoader loader(nullptr, [&checksum](const serenity::EntityDesc& entity) {
+        checksum += entity.name.size();
+    });
+    auto begin = std::chrono::steady_clock::now();
+    const auto stats = loader.Load(path);
+    const auto sax_time = Milliseconds(std::chrono::steady_clock::now() - begin).count();
+    const auto sax_rss = serenity::PeakResidentBytes();
+
+    begin = std::chrono::steady_clock::now();
+    const auto dom = nlohmann::json::parse(std::ifstream(path));
+    const auto dom_time = Milliseconds(std::chrono::steady_clock::now() - begin).count();
+    const auto dom_rss = serenity::PeakResidentBytes();
+
+    nlohmann::json report;
+    report["file_bytes"] = file_size;
+    report["entities"] = stats.entities;
+    report["checksum"] = checksum;
+    report["sax"] = {{"load_ms", sax_time}, {"peak_rss_growth_bytes", sax_rss - baseline_rss}};
+    report["dom"] = {{"load_ms", dom_time}, {"peak_rss_growth_bytes", dom_rss - sax_rss}, {"entities", dom["entities"].size()}};
+    std::cout << report.dump(4) << std::endl;
+    std::filesystem::remove(path);
+    return 0;
+}
\ No newline at end of file
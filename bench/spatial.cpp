@@ -0,0 +1,130 @@
+/**
+ * @file spatial.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "bvh.h"
+#include "glm.hpp"
+#include "json.hpp"
+#include "spatial_hash_grid.h"
+#include "timing.h"
+
+namespace {
+
+constexpr float WORLD = 1000.0F;
+constexpr float RADIUS = 0.5F;
+
+serenity::Aabb Box(const glm::vec3& center) {
+    return {center - RADIUS, center + RADIUS};
+}
+
+}  // namespace
+
+// Usage: spatial [objects] [frames] [queries per frame]. For each share of objects moving per frame, moves them,
+// brings the grid and the BVH up to date and runs the same range queries against both. The grid is timed with O(1)
+// moves alone and with a counting-sort rebuild per frame; the BVH refits and swaps in background rebuilds as it degrades.
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 200000;
+    const size_t frames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 30;
+    const size_t queries = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10000;
+    serenity::ThreadPool pool;
+    nlohmann::json report;
+    report["objects"] = count;
+    report["frames"] = frames;
+    report["queries_per_frame"] = queries;
+    report["threads"] = pool.Size() + 1;
+
+    for (const auto ratio : {0.01, 0.1, 0.5, 1.0}) {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> coordinate(0.0F, WORLD);
+        std::uniform_real_distribution<float> step(-2.0F, 2.0F);
+        std::vector<glm::vec3> positions(count);
+        std::vector<serenity::Aabb> bounds(count);
+        serenity::SpatialHashGrid grid(16.0F);
+        std::vector<serenity::GridObjectId> objects(count);
+        for (size_t i = 0; i < count; ++i) {
+            positions[i] = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+            bounds[i] = Box(positions[i]);
+            objects[i] = grid.Insert(positions[i], RADIUS);
+        }
+        serenity::Bvh bvh;
+        bvh.Build(bounds);
+        grid.Rebuild(pool);
+
+        const auto moving = static_cast<size_t>(static_cast<double>(count) * ratio);
+        double grid_move_ms = 0.0;
+        double grid_rebuild_ms = 0.0;
+        double grid_query_ms = 0.0;
+        double bvh_refit_ms = 0.0;
+        double bvh_query_ms = 0.0;
+        size_t grid_results = 0;
+        size_t bvh_results = 0;
+        std::vector<uint32_t> found;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            // Moving objects are a contiguous run that rotates each frame, so over time all of them move.
+            const auto first = frame * moving % count;
+            for (size_t n = 0; n < moving; ++n) {
+                const auto i = (first + n) % count;
+                positions[i] = glm::clamp(positions[i] + glm::vec3(step(random), step(random), step(random)), glm::vec3(0.0F), glm::vec3(WORLD));
+            }
+            grid_move_ms += serenity::Time([&]() {
+                for (size_t n = 0; n < moving; ++n) {
+                    const auto i = (first + n) % count;
+                    grid.Move(objects[i], positions[i]);
+                }
+            });
+            grid_rebuild_ms += serenity::Time([&]() {
+                grid.Rebuild(pool);
+            });
+            bvh_refit_ms += serenity::Time([&]() {
+                for (size_t n = 0; n < moving; ++n) {
+                    const auto i = (first + n) % count;
+                    bvh.Update(static_cast<uint32_t>(i), Box(positions[i]));
+                }
+                bvh.Refit();
+            });
+
+            std::vector<glm::vec3> centers(queries);
+            for (auto& center : centers) {
+                center = glm::vec3(coordinate(random), coordinate(random), coordinate(random));
+            }
+            grid_query_ms += serenity::Time([&]() {
+                for (const auto& center : centers) {
+                    found.clear();
+                    grid.Overlap({center - 10.0F, center + 10.0F}, found);
+                    grid_results += found.size();
+                }
+            });
+            bvh_query_ms += serenity::Time([&]() {
+                for (const auto& center : centers) {
+                    found.clear();
+                    bvh.Overlap({center - 10.0F, center + 10.0F}, found);
+                    bvh_results += found.size();
+                }
+            });
+        }
+        const auto per_frame = [frames](double milliseconds) {
+            return frames > 0 ? milliseconds / static_cast<double>(frames) : 0.0;
+        };
+        nlohmann::json run;
+        run["motion_ratio"] = ratio;
+        run["moving_per_frame"] = moving;
+        run["grid_move_ms"] = per_frame(grid_move_ms);
+        run["grid_rebuild_ms"] = per_frame(grid_rebuild_ms);
+        run["grid_query_ms"] = per_frame(grid_query_ms);
+        run["bvh_refit_ms"] = per_frame(bvh_refit_ms);
+        run["bvh_query_ms"] = per_frame(bvh_query_ms);
+        run["bvh_degradation"] = bvh.Degradation();
+        run["grid_results"] = grid_results;
+        run["bvh_results"] = bvh_results;
+        report["runs"].push_back(run);
+    }
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
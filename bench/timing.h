@@ -0,0 +1,24 @@
+/**
+ * @file timing.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_BENCH_TIMING_H_)
+#define SERENITY_BENCH_TIMING_H_
+
+#include <chrono>
+
+namespace serenity {
+
+// Wall-clock milliseconds one call of fn takes; what the micro benchmarks report for each step.
+template <typename F>
+double Time(F&& fn) {
+    const auto begin = std::chrono::steady_clock::now();
+    fn();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+}  // namespace serenity
+
+#endif  // SERENITY_BENCH_TIMING_H_
\ No newline at end of file
@@ -0,0 +1,110 @@
+/**
+ * @file transform.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/matrix_transform.hpp"
+#include "gtc/quaternion.hpp"
+#include "json.hpp"
+#include "timing.h"
+#include "transform_hierarchy.h"
+
+namespace {
+
+// World matrix rebuilt from the local transforms up the parent chain, the slow way.
+glm::mat4 Reference(const serenity::TransformHierarchy& hierarchy, serenity::NodeId node) {
+    glm::mat4 world(1.0F);
+    for (; node != serenity::INVALID_NODE; node = hierarchy.Parent(node)) {
+        const auto& local = hierarchy.Local(node);
+        world = glm::translate(glm::mat4(1.0F), local.position) * glm::mat4_cast(local.rotation) * glm::scale(glm::mat4(1.0F), local.scale) * world;
+    }
+    return world;
+}
+
+}  // namespace
+
+// Usage: transform [nodes] [moving fraction] [frames]. Builds a forest of 500-node objects, half of them static, moves
+// a random fraction of the dynamic nodes every frame and times Update() against the first, full one.
+int main(int argc, char** argv) {
+    const size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500000;
+    const double moving = argc > 2 ? std::strtod(argv[2], nullptr) : 0.02;
+    const size_t frames = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 100;
+    constexpr size_t OBJECT_NODES = 500;
+    serenity::TransformHierarchy hierarchy;
+    serenity::ThreadPool pool;
+    std::mt19937 random(42);
+    std::uniform_real_distribution<float> offset(-1.0F, 1.0F);
+    std::vector<serenity::NodeId> nodes;
+    std::vector<serenity::NodeId> dynamic;
+    nodes.reserve(count);
+
+    nlohmann::json report;
+    report["nodes"] = count;
+    report["threads"] = pool.Size() + 1;
+    // Parents are picked at random among the object's earlier nodes, so most adds land outside the parent's subtree
+    // and the first Update() has to re-sort.
+    report["build_ms"] = serenity::Time([&]() {
+        for (size_t i = 0; i < count; ++i) {
+            const auto object_begin = i - i % OBJECT_NODES;
+            const bool is_static = (i / OBJECT_NODES) % 2 == 0;
+            auto parent = serenity::INVALID_NODE;
+            if (i != object_begin) {
+                parent = nodes[std::uniform_int_distribution<size_t>(object_begin, i - 1)(random)];
+            }
+            const serenity::Transform local{glm::vec3(offset(random), offset(random), offset(random)), glm::angleAxis(offset(random), glm::vec3(0.0F, 1.0F, 0.0F)), glm::vec3(1.0F)};
+            nodes.push_back(hierarchy.Add(parent, local, is_static));
+            if (!is_static) {
+                dynamic.push_back(nodes.back());
+            }
+        }
+    });
+    report["full_update_ms"] = serenity::Time([&]() {
+        hierarchy.Update(pool);
+    });
+    report["full_update_nodes"] = hierarchy.Updated();
+
+    const auto moved = static_cast<size_t>(static_cast<double>(dynamic.size()) * moving);
+    std::uniform_int_distribution<size_t> pick(0, dynamic.empty() ? 0 : dynamic.size() - 1);
+    double update_ms = 0.0;
+    size_t updated = 0;
+    for (size_t frame = 0; frame < frames && !dynamic.empty(); ++frame) {
+        for (size_t i = 0; i < moved; ++i) {
+            const auto node = dynamic[pick(random)];
+            auto local = hierarchy.Local(node);
+            local.position += glm::vec3(0.01F, 0.0F, 0.0F);
+            local.rotation = glm::normalize(local.rotation * glm::angleAxis(0.01F, glm::vec3(0.0F, 0.0F, 1.0F)));
+            hierarchy.SetLocal(node, local);
+        }
+        update_ms += serenity::Time([&]() {
+            hierarchy.Update(pool);
+        });
+        updated += hierarchy.Updated();
+    }
+    report["moved_per_frame"] = moved;
+    report["frames"] = frames;
+    report["dirty_update_ms"] = frames > 0 ? update_ms / static_cast<double>(frames) : 0.0;
+    report["dirty_update_nodes"] = frames > 0 ? updated / frames : 0;
+
+    float max_error = 0.0F;
+    for (size_t i = 0; i < nodes.size(); i += 97) {
+        const auto expected = Reference(hierarchy, nodes[i]);
+        const auto& actual = hierarchy.World(nodes[i]);
+        for (glm::length_t column = 0; column < 4; ++column) {
+            for (glm::length_t row = 0; row < 4; ++row) {
+                max_error = std::max(max_error, std::abs(expected[column][row] - actual[column][row]));
+            }
+        }
+    }
+    report["max_error"] = max_error;
+    std::cout << report.dump(4) << std::endl;
+    return max_error < 1e-3F ? 0 : 1;
+}
\ No newline at end of file
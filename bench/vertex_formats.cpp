@@ -0,0 +1,86 @@
+/**
+ * @file vertex_formats.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <iostream>
+#include <string>
+
+#include "json.hpp"
+#include "mesh.h"
+#include "timing.h"
+#include "vertex_format.h"
+
+namespace {
+
+const char* Name(serenity::PositionFormat format) {
+    switch (format) {
+        case serenity::PositionFormat::HALF:
+            return "half";
+        case serenity::PositionFormat::SNORM16:
+            return "snorm16";
+        default:
+            return "float32";
+    }
+}
+
+const char* Name(serenity::NormalFormat format) {
+    return format == serenity::NormalFormat::OCTAHEDRAL16 ? "octahedral16" : "float32";
+}
+
+const char* Name(serenity::UvFormat format) {
+    switch (format) {
+        case serenity::UvFormat::HALF:
+            return "half";
+        case serenity::UvFormat::UNORM16:
+            return "unorm16";
+        default:
+            return "float32";
+    }
+}
+
+nlohmann::json Report(const std::string& asset, const serenity::Mesh& mesh, const serenity::QuantizationBounds& bounds) {
+    serenity::QuantizedMesh quantized;
+    nlohmann::json report;
+    report["asset"] = asset;
+    report["quantize_ms"] = serenity::Time([&]() {
+        quantized = serenity::Quantize(mesh, bounds);
+    });
+    const auto& format = quantized.format;
+    const auto& stats = quantized.report;
+    report["formats"] = {{"position", Name(format.position)}, {"normal", Name(format.normal)}, {"uv", format.uvs ? Name(format.uv) : "none"}};
+    report["strides"] = {{"float", stats.float_bytes / stats.vertices}, {"position", format.PositionStride()}, {"attribute", format.AttributeStride()}};
+    report["vertices"] = stats.vertices;
+    report["float_bytes"] = stats.float_bytes;
+    report["bytes"] = stats.Bytes();
+    report["memory_saving"] = stats.MemorySaving();
+    report["depth_only_saving"] = stats.DepthOnlySaving();
+    report["errors"] = {{"position", stats.position_error}, {"normal_degrees", stats.normal_error}, {"tangent_degrees", stats.tangent_error}, {"uv", stats.uv_error}};
+    report["bounds"] = {{"position", bounds.position_error}, {"normal_degrees", bounds.normal_error}, {"uv", bounds.uv_error}};
+    return report;
+}
+
+}  // namespace
+
+// Quantizes a few procedural assets with the default error bounds and prints what each one saves. The terrain tile
+// is large, so it is also run with a bound suited to its scale; a prop placed far from the origin quantizes as well
+// as one at the origin, since positions are stored relative to the mesh center.
+int main() {
+    serenity::QuantizationBounds defaults;
+    nlohmann::json report;
+    report["assets"].push_back(Report("sphere", serenity::Mesh::Sphere(128, 256, 1.0F), defaults));
+    auto terrain = serenity::Mesh::Terrain(512, 256.0F, 12.0F);
+    report["assets"].push_back(Report("terrain", terrain, defaults));
+    auto coarse = defaults;
+    coarse.position_error = 0.005F;
+    report["assets"].push_back(Report("terrain_coarse", terrain, coarse));
+    auto prop = serenity::Mesh::Sphere(64, 128, 0.5F);
+    for (auto& position : prop.positions) {
+        position += glm::vec3(2000.0F, 0.0F, -1500.0F);
+    }
+    prop.tangents.clear();
+    report["assets"].push_back(Report("offset_prop", prop, defaults));
+    std::cout << report.dump(4) << std::endl;
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+/**
+ * @file benchmark.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_BENCHMARK_H_)
+#define SERENITY_BENCHMARK_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/constants.hpp"
+#include "gtc/quaternion.hpp"
+#include "json.hpp"
+#include "serenity.h"
+
+namespace serenity {
+
+struct CameraPose {
+    glm::vec3 position{0.0F};
+    glm::quat orientation{1.0F, 0.0F, 0.0F, 0.0F};
+};
+
+/**
+ * Closed loop through camera keyframes, sampled by a normalized parameter rather than by time so that every run of a
+ * benchmark renders exactly the same views regardless of how long each frame took.
+ */
+class CameraPath {
+public:
+    explicit CameraPath(std::vector<CameraPose> keyframes);
+    ~CameraPath() = default;
+
+    CameraPath() = delete;
+    CameraPath(const CameraPath& path) = default;
+    CameraPath& operator=(const CameraPath& path) = default;
+    CameraPath(CameraPath&& path) = default;
+    CameraPath& operator=(CameraPath&& path) = default;
+
+public:
+    static CameraPath Orbit(const glm::vec3& center, float radius, float height, size_t keyframes);
+    CameraPose Sample(double t) const;
+
+private:
+    std::vector<CameraPose> keyframes_{};
+};
+
+struct BenchmarkOptions {
+    std::string name{};
+    std::filesystem::path scene{};
+    uint32_t frames{1000};
+    uint32_t warmup_frames{60};
+};
+
+/**
+ * Loads a scene, flies an orbit around its bounds for a fixed number of frames and reports CPU and GPU frame time
+ * percentiles, peak memory, pipeline compiles and startup time as JSON. Warmup frames run the same path but are not
+ * measured. Whether the run is headless follows the "headless" setting of the Serenity it drives. The raw frame
+ * times are part of the report so that two reports can be compared statistically.
+ */
+class Benchmark {
+public:
+    using FrameCallback = std::function<void(const CameraPose& pose, uint32_t frame)>;
+
+    Benchmark(Serenity& app, BenchmarkOptions options);
+    ~Benchmark() = default;
+
+    Benchmark() = delete;
+    Benchmark(const Benchmark& benchmark) = delete;
+    Benchmark& operator=(const Benchmark& benchmark) = delete;
+    Benchmark(Benchmark&& benchmark) = delete;
+    Benchmark& operator=(Benchmark&& benchmark) = delete;
+
+public:
+    void SetFrameCallback(FrameCallback frame);
+    nlohmann::json Run();
+
+private:
+    Serenity& app_;
+    BenchmarkOptions options_;
+    FrameCallback frame_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_BENCHMARK_H_
\ No newline at end of file
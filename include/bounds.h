@@ -0,0 +1,98 @@
+/**
+ * @file bounds.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_BOUNDS_H_)
+#define SERENITY_BOUNDS_H_
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "glm.hpp"
+
+namespace serenity {
+
+struct Aabb {
+    glm::vec3 min{std::numeric_limits<float>::max()};
+    glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+    void Grow(const glm::vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void Grow(const Aabb& box) {
+        min = glm::min(min, box.min);
+        max = glm::max(max, box.max);
+    }
+    bool Empty() const {
+        return min.x > max.x || min.y > max.y || min.z > max.z;
+    }
+    glm::vec3 Center() const {
+        return (min + max) * 0.5F;
+    }
+    float SurfaceArea() const {
+        if (Empty()) {
+            return 0.0F;
+        }
+        const auto extent = max - min;
+        return 2.0F * (extent.x * extent.y + extent.y * extent.z + extent.z * extent.x);
+    }
+    bool Overlaps(const Aabb& box) const {
+        return min.x <= box.max.x && box.min.x <= max.x && min.y <= box.max.y && box.min.y <= max.y && min.z <= box.max.z && box.min.z <= max.z;
+    }
+    bool Contains(const glm::vec3& point) const {
+        return point.x >= min.x && point.x <= max.x && point.y >= min.y && point.y <= max.y && point.z >= min.z && point.z <= max.z;
+    }
+    // Zero when the point is inside.
+    float SquaredDistance(const glm::vec3& point) const {
+        const auto offset = glm::max(glm::max(min - point, point - max), glm::vec3(0.0F));
+        return glm::dot(offset, offset);
+    }
+};
+
+struct Ray {
+    glm::vec3 origin{0.0F};
+    glm::vec3 direction{0.0F, 0.0F, 1.0F};
+    float max_distance{std::numeric_limits<float>::infinity()};
+};
+
+struct RayHit {
+    static constexpr uint32_t MISS = ~uint32_t{0};
+
+    uint32_t primitive{MISS};
+    float distance{std::numeric_limits<float>::infinity()};
+
+    bool Hit() const {
+        return primitive != MISS;
+    }
+};
+
+// Distance along the ray to where it enters the box, or a negative value when it misses within max_distance.
+float Intersect(const Ray& ray, const Aabb& box);
+
+enum class Containment {
+    OUTSIDE,
+    INTERSECTS,
+    INSIDE,
+};
+
+/**
+ * Six planes facing into the view volume, as (normal, distance) with the normal in xyz. Extracted from a
+ * view-projection matrix with Vulkan's [0, 1] depth range.
+ */
+struct Frustum {
+    std::array<glm::vec4, 6> planes{};
+
+    static Frustum FromViewProjection(const glm::mat4& view_projection);
+    // Box around the eight corners; unbounded if the far plane is at infinity.
+    Aabb Bounds() const;
+    Containment Classify(const Aabb& box) const;
+    bool Intersects(const glm::vec3& center, float radius) const;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_BOUNDS_H_
\ No newline at end of file
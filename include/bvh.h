@@ -0,0 +1,132 @@
+/**
+ * @file bvh.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_BVH_H_)
+#define SERENITY_BVH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <new>
+#include <vector>
+
+#include "bounds.h"
+#include "glm.hpp"
+
+namespace serenity {
+
+/**
+ * Bounding volume hierarchy over primitive boxes, built top-down with a binned surface area heuristic. Nodes are 32
+ * bytes in one flat, cache-line aligned array; slot 1 is left empty so that every sibling pair starts on a cache
+ * line and both children of a node load together. Primitives that
+ * move are updated in place and Refit() grows the boxes bottom-up; once refitting has degraded the tree past
+ * REBUILD_DEGRADATION, a rebuild starts on a background thread and a later Refit() swaps it in. Queries append
+ * primitive indices and may run concurrently with each other, but not with Build(), Update() or Refit().
+ */
+class Bvh {
+public:
+    static constexpr uint32_t BINS = 16;
+    static constexpr uint32_t MAX_LEAF_PRIMITIVES = 4;
+    // SAH cost relative to the freshly built tree at which Refit() schedules a rebuild.
+    static constexpr float REBUILD_DEGRADATION = 1.5F;
+
+    // Returns the hit distance along the ray, or a negative value for a miss.
+    using Intersector = std::function<float(uint32_t primitive, const Ray& ray)>;
+
+    Bvh() = default;
+    ~Bvh() = default;
+
+    Bvh(const Bvh& bvh) = delete;
+    Bvh& operator=(const Bvh& bvh) = delete;
+    Bvh(Bvh&& bvh) = delete;
+    Bvh& operator=(Bvh&& bvh) = delete;
+
+public:
+    void Build(std::vector<Aabb> bounds);
+    size_t Size() const;
+    size_t NodeCount() const;
+    const Aabb& Bounds(uint32_t primitive) const;
+    void Update(uint32_t primitive, const Aabb& bounds);
+    void Refit();
+    // True after Update() until the next Refit(), and while a rebuild waits to be swapped in.
+    bool NeedsRefit() const;
+    // SAH cost of the current tree, and that cost relative to the tree as built.
+    float Cost() const;
+    float Degradation() const;
+    void RebuildAsync();
+    bool Rebuilding() const;
+
+    // Nearest hit. Without an intersector the primitive boxes are the geometry, which is enough for picking.
+    RayHit Raycast(const Ray& ray, const Intersector& intersect = nullptr) const;
+    void Overlap(const Aabb& box, std::vector<uint32_t>& primitives) const;
+    void Nearby(const glm::vec3& center, float radius, std::vector<uint32_t>& primitives) const;
+    void Cull(const Frustum& frustum, std::vector<uint32_t>& primitives) const;
+
+private:
+    // Leaves have a count and index primitives_[offset, offset + count); interior nodes have a zero count and their
+    // children at offset and offset + 1. Each bound is followed by an integer so it loads as one 16-byte vector.
+    struct alignas(32) Node {
+        glm::vec3 min;
+        uint32_t count;
+        glm::vec3 max;
+        uint32_t offset;
+    };
+
+    static constexpr size_t CACHE_LINE = 64;
+    // The root is alone at slot 0; sibling pairs start at 2.
+    static constexpr uint32_t PADDING_NODE = 1;
+
+    template <typename T>
+    struct CacheLineAllocator {
+        using value_type = T;
+
+        CacheLineAllocator() = default;
+        template <typename U>
+        CacheLineAllocator(const CacheLineAllocator<U>&) {
+        }
+
+        T* allocate(size_t count) {
+            return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t{CACHE_LINE}));
+        }
+        void deallocate(T* pointer, size_t) {
+            ::operator delete(pointer, std::align_val_t{CACHE_LINE});
+        }
+        bool operator==(const CacheLineAllocator&) const {
+            return true;
+        }
+        bool operator!=(const CacheLineAllocator&) const {
+            return false;
+        }
+    };
+
+    using Nodes = std::vector<Node, CacheLineAllocator<Node>>;
+
+    struct Tree {
+        Nodes nodes;
+        std::vector<uint32_t> primitives;
+        float cost;
+    };
+
+private:
+    static Tree BuildTree(const std::vector<Aabb>& bounds);
+    static float SahCost(const Nodes& nodes);
+    void Adopt(Tree tree);
+    void CollectSubtree(uint32_t node, std::vector<uint32_t>& primitives) const;
+
+private:
+    std::vector<Aabb> bounds_{};
+    Nodes nodes_{};
+    std::vector<uint32_t> primitives_{};
+    float built_cost_{0.0F};
+    float cost_{0.0F};
+    bool updated_{false};
+    std::future<Tree> rebuild_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_BVH_H_
\ No newline at end of file
@@ -0,0 +1,107 @@
+/**
+ * @file config.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_CONFIG_H_)
+#define SERENITY_CONFIG_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json.hpp"
+#include "spdlog.h"
+
+namespace serenity {
+
+/**
+ * Every key of serenity.json. Members are named after their keys so the reflection macro below maps them without
+ * string lookups elsewhere; keys missing from the file keep the defaults given here.
+ */
+struct Settings {
+    std::string log_name{"serenity"};
+    std::string log_path{"log/"};
+    std::string log_level{"trace"};
+    int window_width{800};
+    int window_height{600};
+    std::string window_title{"serenity"};
+    float clear_color_red{0.17F};
+    float clear_color_green{0.17F};
+    float clear_color_blue{0.17F};
+    float clear_color_alpha{1.0F};
+    double simulation_rate{60.0};
+    uint32_t max_simulation_steps{5};
+    bool continuous_rendering{false};
+    double idle_wait_timeout{0.5};
+    double target_frame_time{0.0};
+    uint32_t max_queued_frames{2};
+    uint32_t frames_in_flight{2};
+    uint32_t gpu_profiler_max_passes{64};
+    std::string profile_capture_path{};
+    bool gpu_pipeline_statistics{false};
+    double memory_budget_fraction{0.9};
+    bool headless{false};
+    double flight_recorder_window{10.0};
+    double hitch_budget{0.1};
+    std::string flight_recorder_path{};
+    uint32_t metrics_port{0};
+    uint32_t instancing_threshold{2};
+    float lod_pixel_error{1.0F};
+    float lod_hysteresis{0.25F};
+    double lod_fade_time{0.0};
+
+    bool operator==(const Settings& settings) const = default;
+};
+
+NLOHMANN_DEFINE_TYPE_NON_INTRUSIVE_WITH_DEFAULT(Settings, log_name, log_path, log_level, window_width, window_height, window_title, clear_color_red, clear_color_green, clear_color_blue, clear_color_alpha, simulation_rate, max_simulation_steps, continuous_rendering, idle_wait_timeout, target_frame_time, max_queued_frames, frames_in_flight, gpu_profiler_max_passes, profile_capture_path, gpu_pipeline_statistics, memory_budget_fraction, headless, flight_recorder_window, hitch_budget, flight_recorder_path, metrics_port, instancing_threshold, lod_pixel_error, lod_hysteresis, lod_fade_time)
+
+/**
+ * serenity.json, mapped once into Settings and watched for changes. Poll() never blocks: on Linux it drains an
+ * inotify watch on the containing directory (editors usually replace the file rather than rewrite it), elsewhere it
+ * compares modification times. Large files are cached next to the source as MessagePack so later starts skip text
+ * parsing; the cache records the size and modification time of the source it was built from and is used only while
+ * both still match.
+ */
+class Config {
+public:
+    explicit Config(const std::filesystem::path& path);
+    ~Config();
+
+    Config() = delete;
+    Config(const Config& config) = delete;
+    Config& operator=(const Config& config) = delete;
+    Config(Config&& config) = delete;
+    Config& operator=(Config&& config) = delete;
+
+public:
+    const Settings& Get() const;
+    const Settings& Previous() const;
+    void SetLogger(const std::shared_ptr<spdlog::logger>& logger);
+    bool Poll();
+
+private:
+    bool Changed();
+    Settings Load();
+    void ReportUnknownKeys();
+    void Validate(const Settings& settings) const;
+
+private:
+    std::filesystem::path path_{};
+    std::filesystem::path cache_path_{};
+    Settings settings_{};
+    Settings previous_{};
+    std::filesystem::file_time_type write_time_{};
+    int inotify_fd_{-1};
+    int watch_fd_{-1};
+    std::vector<std::string> unknown_keys_{};
+    std::shared_ptr<spdlog::logger> logger_;
+    static constexpr std::uintmax_t CACHE_THRESHOLD_ = 64 * 1024;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_CONFIG_H_
\ No newline at end of file
@@ -0,0 +1,121 @@
+/**
+ * @file cpu_profiler.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_CPU_PROFILER_H_)
+#define SERENITY_CPU_PROFILER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#if defined(SERENITY_ENABLE_PROFILING)
+#define SERENITY_ZONE_CONCAT_(a, b) a##b
+#define SERENITY_ZONE_VARIABLE_(line) SERENITY_ZONE_CONCAT_(serenity_zone_, line)
+#define SERENITY_ZONE(name) const ::serenity::ProfileZone SERENITY_ZONE_VARIABLE_(__LINE__)(name)
+#define SERENITY_ZONE_FUNCTION() SERENITY_ZONE(__func__)
+#define SERENITY_ZONE_THREAD_NAME(name) ::serenity::CpuProfiler::Get().SetThreadName(name)
+#else
+#define SERENITY_ZONE(name)
+#define SERENITY_ZONE_FUNCTION()
+#define SERENITY_ZONE_THREAD_NAME(name)
+#endif  // SERENITY_ENABLE_PROFILING
+
+namespace serenity {
+
+struct ZoneEvent {
+    const char* name{nullptr};
+    uint64_t begin{0};
+    uint64_t end{0};
+};
+
+struct ThreadCapture {
+    uint32_t id{0};
+    std::string name{};
+    std::vector<ZoneEvent> events{};
+};
+
+/**
+ * Process-wide recorder behind the SERENITY_ZONE macros, which compile to nothing unless SERENITY_ENABLE_PROFILING
+ * is defined. Every thread writes completed zones into its own ring buffer without locking; only the first zone on
+ * a thread takes the registry lock. Timestamps are raw TSC ticks where available and are converted to nanoseconds
+ * when a capture is taken. Zone names must outlive the capture, which string literals and __func__ do.
+ */
+class CpuProfiler {
+public:
+    static CpuProfiler& Get();
+
+    CpuProfiler(const CpuProfiler& profiler) = delete;
+    CpuProfiler& operator=(const CpuProfiler& profiler) = delete;
+    CpuProfiler(CpuProfiler&& profiler) = delete;
+    CpuProfiler& operator=(CpuProfiler&& profiler) = delete;
+
+public:
+    static uint64_t Now();
+    void Record(const char* name, uint64_t begin, uint64_t end);
+    void RecordGpu(const std::string& name, uint64_t begin, uint64_t end);
+    void SetThreadName(const std::string& name);
+    double NanosecondsPerTick();
+    std::vector<ThreadCapture> Capture();
+    void ExportChromeTrace(const std::filesystem::path& path);
+    void ExportPerfetto(const std::filesystem::path& path);
+    void Export(const std::filesystem::path& path);
+
+private:
+    static constexpr size_t CAPACITY_ = size_t{1} << 16;
+
+    struct ThreadBuffer {
+        uint32_t id{0};
+        std::string name{};
+        std::atomic<uint64_t> head{0};
+        std::array<ZoneEvent, CAPACITY_> events{};
+    };
+
+private:
+    CpuProfiler();
+    ~CpuProfiler() = default;
+
+    ThreadBuffer& LocalBuffer();
+    static void Push(ThreadBuffer& buffer, const ZoneEvent& event);
+    static std::vector<ZoneEvent> Snapshot(const ThreadBuffer& buffer);
+
+private:
+    std::mutex mutex_{};
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers_{};
+    ThreadBuffer* gpu_buffer_{nullptr};
+    std::set<std::string> gpu_names_{};
+    double nanoseconds_per_tick_{0.0};
+    uint64_t origin_ticks_{0};
+    std::chrono::steady_clock::time_point origin_time_{};
+};
+
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name) : name_(name), begin_(CpuProfiler::Now()) {}
+    ~ProfileZone() {
+        CpuProfiler::Get().Record(name_, begin_, CpuProfiler::Now());
+    }
+
+    ProfileZone() = delete;
+    ProfileZone(const ProfileZone& zone) = delete;
+    ProfileZone& operator=(const ProfileZone& zone) = delete;
+    ProfileZone(ProfileZone&& zone) = delete;
+    ProfileZone& operator=(ProfileZone&& zone) = delete;
+
+private:
+    const char* name_;
+    uint64_t begin_;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_CPU_PROFILER_H_
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * @file debug_utils.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_DEBUG_UTILS_H_)
+#define SERENITY_DEBUG_UTILS_H_
+
+#include <cstdint>
+#include <string>
+
+#include "vulkan/vulkan.h"
+
+#if !defined(NODEBUG)
+#define SERENITY_DEBUG_CONCAT_(a, b) a##b
+#define SERENITY_DEBUG_VARIABLE_(line) SERENITY_DEBUG_CONCAT_(serenity_debug_label_, line)
+#define SERENITY_DEBUG_NAME(device, type, handle, name) ::serenity::DebugUtils::SetObjectName(device, type, handle, name)
+#define SERENITY_DEBUG_LABEL_BEGIN(command_buffer, name) ::serenity::DebugUtils::BeginLabel(command_buffer, name)
+#define SERENITY_DEBUG_LABEL_END(command_buffer) ::serenity::DebugUtils::EndLabel(command_buffer)
+#define SERENITY_DEBUG_LABEL(command_buffer, name) const ::serenity::DebugLabel SERENITY_DEBUG_VARIABLE_(__LINE__)(command_buffer, name)
+#else
+#define SERENITY_DEBUG_NAME(device, type, handle, name)
+#define SERENITY_DEBUG_LABEL_BEGIN(command_buffer, name)
+#define SERENITY_DEBUG_LABEL_END(command_buffer)
+#define SERENITY_DEBUG_LABEL(command_buffer, name)
+#endif  // NODEBUG
+
+#if !defined(NODEBUG)
+
+namespace serenity {
+
+/**
+ * VK_EXT_debug_utils object names and command buffer labels, which validation messages, RenderDoc and vendor
+ * profilers show instead of raw handles. Use the SERENITY_DEBUG_* macros: they compile to nothing, arguments
+ * included, when NODEBUG is defined, which is also when Instance leaves the extension disabled. Until Load() finds
+ * the entry points every call is a no-op.
+ */
+class DebugUtils {
+public:
+    DebugUtils() = delete;
+
+public:
+    static void Load(VkInstance instance);
+    static void SetObjectName(VkDevice device, VkObjectType type, uint64_t handle, const std::string& name);
+    static void BeginLabel(VkCommandBuffer command_buffer, const std::string& name);
+    static void EndLabel(VkCommandBuffer command_buffer);
+
+    template <typename Handle>
+    static void SetObjectName(VkDevice device, VkObjectType type, Handle handle, const std::string& name) {
+        SetObjectName(device, type, reinterpret_cast<uint64_t>(handle), name);
+    }
+
+private:
+    static PFN_vkSetDebugUtilsObjectNameEXT set_object_name_;
+    static PFN_vkCmdBeginDebugUtilsLabelEXT begin_label_;
+    static PFN_vkCmdEndDebugUtilsLabelEXT end_label_;
+};
+
+class DebugLabel {
+public:
+    DebugLabel(VkCommandBuffer command_buffer, const std::string& name) : command_buffer_(command_buffer) {
+        DebugUtils::BeginLabel(command_buffer_, name);
+    }
+    ~DebugLabel() {
+        DebugUtils::EndLabel(command_buffer_);
+    }
+
+    DebugLabel() = delete;
+    DebugLabel(const DebugLabel& label) = delete;
+    DebugLabel& operator=(const DebugLabel& label) = delete;
+    DebugLabel(DebugLabel&& label) = delete;
+    DebugLabel& operator=(DebugLabel&& label) = delete;
+
+private:
+    VkCommandBuffer command_buffer_;
+};
+
+}  // namespace serenity
+
+#endif  // NODEBUG
+
+#endif  // SERENITY_DEBUG_UTILS_H_
\ No newline at end of file
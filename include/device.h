@@ -0,0 +1,72 @@
+/**
+ * @file device.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_DEVICE_H_)
+#define SERENITY_DEVICE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "instance.h"
+#include "spdlog.h"
+#include "vulkan/vulkan.h"
+
+namespace serenity {
+
+class Device {
+public:
+    Device(const Instance& instance, const std::shared_ptr<spdlog::logger>& logger);
+    ~Device();
+
+    Device() = delete;
+    Device(const Device& device) = delete;
+    Device& operator=(const Device& device) = delete;
+    Device(Device&& device) = delete;
+    Device& operator=(Device&& device) = delete;
+
+public:
+    VkDevice Handle() const;
+    VkPhysicalDevice PhysicalDevice() const;
+    VkQueue GraphicsQueue() const;
+    uint32_t GraphicsQueueFamily() const;
+    const VkPhysicalDeviceProperties& Properties() const;
+    uint32_t TimestampValidBits() const;
+    const VkPhysicalDeviceFeatures& Features() const;
+    const Instance& GetInstance() const;
+    bool MemoryBudgetEnabled() const;
+    bool MemoryPriorityEnabled() const;
+    bool PageableMemoryEnabled() const;
+    void CountPipelineCompile() const;
+    uint64_t PipelineCompiles() const;
+
+private:
+    void PickPhysicalDevice();
+    std::optional<uint32_t> FindGraphicsQueueFamily(VkPhysicalDevice physical_device) const;
+    bool IsExtensionSupported(VkPhysicalDevice physical_device, const char* extension) const;
+    void CreateLogicalDevice();
+
+private:
+    const Instance& instance_;
+    VkPhysicalDevice physical_device_ = nullptr;
+    VkDevice device_ = nullptr;
+    VkQueue graphics_queue_ = nullptr;
+    uint32_t graphics_queue_family_{0};
+    uint32_t timestamp_valid_bits_{0};
+    VkPhysicalDeviceProperties properties_{};
+    VkPhysicalDeviceFeatures features_{};
+    bool memory_budget_{false};
+    bool memory_priority_{false};
+    bool pageable_memory_{false};
+    mutable std::atomic<uint64_t> pipeline_compiles_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_DEVICE_H_
\ No newline at end of file
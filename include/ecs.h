@@ -0,0 +1,348 @@
+/**
+ * @file ecs.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_ECS_H_)
+#define SERENITY_ECS_H_
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace serenity {
+
+using ComponentId = uint32_t;
+constexpr size_t MAX_COMPONENTS = 64;
+using ComponentMask = std::bitset<MAX_COMPONENTS>;
+
+struct ComponentInfo {
+    size_t size{0};
+    size_t alignment{0};
+    void (*move_construct)(void* destination, void* source){nullptr};
+    void (*destroy)(void* object){nullptr};
+};
+
+/**
+ * Process-wide component type registry. Ids are handed out on first use of a type, so they differ between runs and
+ * must not be persisted.
+ */
+class Components {
+public:
+    Components() = delete;
+
+public:
+    template <typename T>
+    static ComponentId Id() {
+        static const ComponentId id = Register({sizeof(T), alignof(T), [](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); }, [](void* object) { static_cast<T*>(object)->~T(); }});
+        return id;
+    }
+
+    template <typename... Ts>
+    static ComponentMask Mask() {
+        ComponentMask mask;
+        (mask.set(Id<std::remove_const_t<Ts>>()), ...);
+        return mask;
+    }
+
+    static const ComponentInfo& Info(ComponentId id);
+
+private:
+    static ComponentId Register(const ComponentInfo& info);
+};
+
+struct Entity {
+    uint32_t index{INVALID};
+    uint32_t generation{0};
+
+    static constexpr uint32_t INVALID = ~uint32_t{0};
+    bool Valid() const {
+        return index != INVALID;
+    }
+    bool operator==(const Entity& entity) const = default;
+};
+
+/**
+ * All entities with exactly one set of components. Rows live in fixed-size chunks; inside a chunk every component is
+ * a contiguous array (SoA) next to the array of entity handles, so a query touches only the arrays it asked for.
+ * Rows stay dense: erasing one moves the last row into the hole.
+ */
+class Archetype {
+public:
+    static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+    explicit Archetype(const ComponentMask& mask);
+    ~Archetype();
+
+    Archetype() = delete;
+    Archetype(const Archetype& archetype) = delete;
+    Archetype& operator=(const Archetype& archetype) = delete;
+    Archetype(Archetype&& archetype) = delete;
+    Archetype& operator=(Archetype&& archetype) = delete;
+
+public:
+    const ComponentMask& Mask() const;
+    const std::vector<ComponentId>& ComponentIds() const;
+    bool Has(ComponentId id) const;
+    size_t Size() const;
+    size_t ChunkCapacity() const;
+    size_t ChunkCount() const;
+    size_t ChunkSize(size_t chunk) const;
+    std::byte* ChunkData(size_t chunk) const;
+    size_t Offset(ComponentId id) const;
+    Entity* Entities(size_t chunk) const;
+    void* Component(ComponentId id, size_t row) const;
+    // Appends a row with uninitialized components that the caller must construct.
+    size_t Push(Entity entity);
+    // Destroys the row's components and returns the entity moved into the row, if any.
+    Entity Erase(size_t row);
+    Archetype*& AddEdge(ComponentId id);
+    Archetype*& RemoveEdge(ComponentId id);
+
+private:
+    struct ChunkDeleter {
+        void operator()(std::byte* memory) const;
+    };
+
+    struct Chunk {
+        std::unique_ptr<std::byte[], ChunkDeleter> memory;
+        size_t size{0};
+    };
+
+private:
+    ComponentMask mask_;
+    std::vector<ComponentId> components_{};
+    std::array<size_t, MAX_COMPONENTS> offsets_{};
+    size_t capacity_{0};
+    size_t size_{0};
+    std::vector<Chunk> chunks_{};
+    std::unordered_map<ComponentId, Archetype*> add_edges_{};
+    std::unordered_map<ComponentId, Archetype*> remove_edges_{};
+};
+
+/**
+ * Archetype-based entity component system. Entities are generational handles; adding or removing a component moves
+ * the entity to the archetype of its new component set, following cached archetype edges. Queries name their
+ * components as template arguments, const for read-only access, and visit matching chunks as contiguous arrays.
+ * Structural changes (create, destroy, add, remove) must not happen while a query runs.
+ */
+class World {
+public:
+    World();
+    ~World() = default;
+
+    World(const World& world) = delete;
+    World& operator=(const World& world) = delete;
+    World(World&& world) = delete;
+    World& operator=(World&& world) = delete;
+
+public:
+    template <typename... Ts>
+    Entity Create(Ts&&... components) {
+        const auto mask = Components::Mask<std::decay_t<Ts>...>();
+        if (mask.count() != sizeof...(Ts)) {
+            throw std::runtime_error("An entity cannot hold two components of the same type.");
+        }
+        auto& archetype = FindOrCreate(mask);
+        const auto entity = Allocate();
+        const auto row = archetype.Push(entity);
+        (new (archetype.Component(Components::Id<std::decay_t<Ts>>(), row)) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+        locations_[entity.index] = {&archetype, row};
+        return entity;
+    }
+
+    void Destroy(Entity entity);
+    bool Alive(Entity entity) const;
+    size_t Size() const;
+    size_t ArchetypeCount() const;
+
+    template <typename T>
+    void Add(Entity entity, T&& component) {
+        using Type = std::decay_t<T>;
+        if (auto* existing = Get<Type>(entity)) {
+            *existing = std::forward<T>(component);
+            return;
+        }
+        CheckAlive(entity);
+        const auto id = Components::Id<Type>();
+        auto& source = *locations_[entity.index].archetype;
+        auto*& target = source.AddEdge(id);
+        if (target == nullptr) {
+            target = &FindOrCreate(ComponentMask(source.Mask()).set(id));
+        }
+        Relocate(entity, *target);
+        const auto& location = locations_[entity.index];
+        new (location.archetype->Component(id, location.row)) Type(std::forward<T>(component));
+    }
+
+    template <typename T>
+    void Remove(Entity entity) {
+        CheckAlive(entity);
+        const auto id = Components::Id<T>();
+        auto& source = *locations_[entity.index].archetype;
+        if (!source.Has(id)) {
+            return;
+        }
+        auto*& target = source.RemoveEdge(id);
+        if (target == nullptr) {
+            target = &FindOrCreate(ComponentMask(source.Mask()).reset(id));
+        }
+        Relocate(entity, *target);
+    }
+
+    template <typename T>
+    T* Get(Entity entity) const {
+        if (!Alive(entity)) {
+            return nullptr;
+        }
+        const auto& location = locations_[entity.index];
+        const auto id = Components::Id<T>();
+        return location.archetype->Has(id) ? static_cast<T*>(location.archetype->Component(id, location.row)) : nullptr;
+    }
+
+    template <typename T>
+    bool Has(Entity entity) const {
+        return Alive(entity) && locations_[entity.index].archetype->Has(Components::Id<T>());
+    }
+
+    // fn(size_t count, const Entity* entities, Ts*... arrays) once per matching chunk.
+    template <typename... Ts, typename F>
+    void EachChunk(F&& fn) const {
+        const auto required = Components::Mask<Ts...>();
+        for (const auto& archetype : archetypes_) {
+            if ((archetype->Mask() & required) != required) {
+                continue;
+            }
+            for (size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk) {
+                VisitChunk<Ts...>(*archetype, chunk, fn);
+            }
+        }
+    }
+
+    // fn(Ts&... components) once per matching entity.
+    template <typename... Ts, typename F>
+    void Each(F&& fn) const {
+        EachChunk<Ts...>([&fn](size_t count, const Entity*, Ts*... arrays) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(arrays[i]...);
+            }
+        });
+    }
+
+    // EachChunk() with chunks spread over the pool. fn runs concurrently and must only touch the given chunk.
+    template <typename... Ts, typename F>
+    void ParallelEachChunk(ThreadPool& pool, F&& fn) const {
+        const auto required = Components::Mask<Ts...>();
+        std::vector<std::pair<Archetype*, size_t>> chunks;
+        for (const auto& archetype : archetypes_) {
+            if ((archetype->Mask() & required) != required) {
+                continue;
+            }
+            for (size_t chunk = 0; chunk < archetype->ChunkCount(); ++chunk) {
+                chunks.emplace_back(archetype.get(), chunk);
+            }
+        }
+        pool.ParallelFor(chunks.size(), [&chunks, &fn](size_t index) {
+            VisitChunk<Ts...>(*chunks[index].first, chunks[index].second, fn);
+        });
+    }
+
+    template <typename... Ts, typename F>
+    void ParallelEach(ThreadPool& pool, F&& fn) const {
+        ParallelEachChunk<Ts...>(pool, [&fn](size_t count, const Entity*, Ts*... arrays) {
+            for (size_t i = 0; i < count; ++i) {
+                fn(arrays[i]...);
+            }
+        });
+    }
+
+private:
+    struct Location {
+        Archetype* archetype{nullptr};
+        size_t row{0};
+    };
+
+private:
+    template <typename... Ts, typename F>
+    static void VisitChunk(const Archetype& archetype, size_t chunk, F& fn) {
+        auto* data = archetype.ChunkData(chunk);
+        fn(archetype.ChunkSize(chunk), archetype.Entities(chunk), reinterpret_cast<Ts*>(data + archetype.Offset(Components::Id<std::remove_const_t<Ts>>()))...);
+    }
+
+    Archetype& FindOrCreate(const ComponentMask& mask);
+    Entity Allocate();
+    void CheckAlive(Entity entity) const;
+    void Relocate(Entity entity, Archetype& target);
+
+private:
+    std::vector<std::unique_ptr<Archetype>> archetypes_{};
+    std::unordered_map<ComponentMask, Archetype*> lookup_{};
+    std::vector<Location> locations_{};
+    std::vector<uint32_t> generations_{};
+    std::vector<uint32_t> free_{};
+    size_t size_{0};
+};
+
+/**
+ * Runs per-entity systems over a world. Each system's read and write sets come from the const-ness of its component
+ * types; Run() packs systems into stages so that no two systems in a stage write a component the other reads or
+ * writes, keeps conflicting systems in the order they were added, and runs the systems of a stage concurrently.
+ */
+class SystemScheduler {
+public:
+    SystemScheduler() = default;
+    ~SystemScheduler() = default;
+
+    SystemScheduler(const SystemScheduler& scheduler) = delete;
+    SystemScheduler& operator=(const SystemScheduler& scheduler) = delete;
+    SystemScheduler(SystemScheduler&& scheduler) = delete;
+    SystemScheduler& operator=(SystemScheduler&& scheduler) = delete;
+
+public:
+    template <typename... Ts, typename F>
+    void Add(const std::string& name, F fn) {
+        ComponentMask reads;
+        ComponentMask writes;
+        ((std::is_const_v<Ts> ? reads : writes).set(Components::Id<std::remove_const_t<Ts>>()), ...);
+        systems_.push_back({name, reads, writes, [fn](World& world, ThreadPool& pool) {
+                                world.ParallelEach<Ts...>(pool, fn);
+                            }});
+        stages_.clear();
+    }
+
+    void Run(World& world, ThreadPool& pool);
+    std::vector<std::vector<std::string>> Stages();
+
+private:
+    struct System {
+        std::string name;
+        ComponentMask reads;
+        ComponentMask writes;
+        std::function<void(World&, ThreadPool&)> run;
+    };
+
+private:
+    static bool Conflicts(const System& a, const System& b);
+    void Plan();
+
+private:
+    std::vector<System> systems_{};
+    std::vector<std::vector<size_t>> stages_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_ECS_H_
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+ * @file flight_recorder.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_FLIGHT_RECORDER_H_)
+#define SERENITY_FLIGHT_RECORDER_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "spdlog/sinks/sink.h"
+
+namespace serenity {
+
+/**
+ * Always-on recorder that keeps the last few seconds of frame zones, GPU pass timings and allocations, plus the
+ * latest log lines through LogSink(). EndFrame() dumps a Chrome trace when a frame runs past the hitch budget, at most
+ * once per recording window: the raw entries are copied under the lock and serialized and written on a background
+ * thread. Once the crash handler is installed, each entry is also formatted as it is recorded into a fixed ring of
+ * trace event fragments, so the signal handler only opens a file, writes the ring and closes it before handing the
+ * signal to whichever handler was installed before it. A crash dump holds the last CRASH_EVENTS_ entries, log lines
+ * included, and an entry overwritten while the handler runs may come out torn. With SERENITY_ENABLE_PROFILING the
+ * full CPU zone capture is written next to hitch dumps.
+ */
+class FlightRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static FlightRecorder& Get();
+
+    FlightRecorder(const FlightRecorder& recorder) = delete;
+    FlightRecorder& operator=(const FlightRecorder& recorder) = delete;
+    FlightRecorder(FlightRecorder&& recorder) = delete;
+    FlightRecorder& operator=(FlightRecorder&& recorder) = delete;
+
+public:
+    void Configure(double window, double hitch_budget, const std::filesystem::path& directory);
+    std::shared_ptr<spdlog::sinks::sink> LogSink() const;
+    void InstallCrashHandler();
+    void RecordZone(const char* name, Clock::time_point begin, Clock::time_point end);
+    void RecordGpuPass(const std::string& name, double milliseconds);
+    void RecordAllocation(const char* category, uint32_t heap, int64_t bytes);
+    // A formatted line, as LogSink() passes it on.
+    void RecordLog(std::string_view line);
+    std::filesystem::path EndFrame(Clock::time_point begin, Clock::time_point end);
+    std::filesystem::path Dump(const std::string& reason);
+
+private:
+    struct Zone {
+        const char* name;
+        Clock::time_point begin;
+        Clock::time_point end;
+    };
+
+    struct GpuPass {
+        std::string name;
+        Clock::time_point time;
+        double milliseconds;
+    };
+
+    struct Allocation {
+        const char* category;
+        uint32_t heap;
+        Clock::time_point time;
+        int64_t bytes;
+        int64_t total;
+    };
+
+    // What a dump serializes, copied out from under the lock.
+    struct Capture {
+        Clock::time_point origin;
+        std::vector<Zone> zones;
+        std::vector<GpuPass> gpu_passes;
+        std::vector<Allocation> allocations;
+        std::vector<std::string> logs;
+    };
+
+    static constexpr size_t CRASH_EVENT_BYTES_ = 256;
+
+    // One preformatted trace event, or two for an allocation and its running total. A zero length marks a slot that
+    // is empty or being rewritten.
+    struct CrashEvent {
+        std::atomic<uint32_t> length{0};
+        char text[CRASH_EVENT_BYTES_];
+    };
+
+private:
+    FlightRecorder();
+    ~FlightRecorder() = default;
+
+    void Trim(Clock::time_point now);
+    Capture Snapshot() const;
+    static std::string Serialize(const Capture& capture, const std::string& reason);
+    std::filesystem::path NextPath(const std::string& reason) const;
+    double Micros(Clock::time_point time) const;
+    void PublishCrashPath();
+    // The next ring slot, marked empty, or null without a crash handler; EndCrashEvent() publishes what
+    // snprintf() wrote into it.
+    CrashEvent* BeginCrashEvent();
+    void EndCrashEvent(CrashEvent* event, int length);
+    // Async-signal-safe.
+    void WriteCrashDump() const;
+#if defined(_WIN32)
+    static void OnCrash(int signal);
+#else
+    static void OnCrash(int signal, siginfo_t* info, void* context);
+#endif
+
+private:
+    mutable std::mutex mutex_{};
+    Clock::duration window_{std::chrono::seconds(10)};
+    Clock::duration hitch_budget_{0};
+    std::filesystem::path directory_{};
+    Clock::time_point origin_{};
+    Clock::time_point last_dump_{};
+    std::deque<Zone> zones_{};
+    std::deque<GpuPass> gpu_passes_{};
+    std::deque<Allocation> allocations_{};
+    std::map<std::string, int64_t> allocated_{};
+    std::deque<std::string> logs_{};
+    std::shared_ptr<spdlog::sinks::sink> log_sink_;
+    std::future<void> writer_{};
+    // Written under mutex_ and read by the signal handler without it. Two paths so that Configure() can rewrite one
+    // while the handler may be reading the other.
+    std::unique_ptr<CrashEvent[]> crash_events_{};
+    std::atomic<uint64_t> crash_event_count_{0};
+    std::array<std::string, 2> crash_paths_{};
+    std::atomic<const std::string*> crash_path_{nullptr};
+    static constexpr size_t LOG_LINES_ = 1024;
+    static constexpr size_t CRASH_EVENTS_ = 4096;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_FLIGHT_RECORDER_H_
\ No newline at end of file
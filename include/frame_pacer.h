@@ -0,0 +1,89 @@
+/**
+ * @file frame_pacer.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_FRAME_PACER_H_)
+#define SERENITY_FRAME_PACER_H_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "spdlog.h"
+#include "statistics.h"
+
+namespace serenity {
+
+struct LatencyPercentiles {
+    double p50{0.0};
+    double p90{0.0};
+    double p99{0.0};
+    size_t samples{0};
+};
+
+/**
+ * Paces the frame loop. BeginFrame() first bounds the presentation queue (through a present waiter backed by
+ * VK_KHR_present_wait once a swapchain provides one) and then waits until the next target frame time, so input is
+ * sampled as late as possible before submission. With an event waiter the wait dispatches window events as they
+ * arrive, so input is timestamped when it happens rather than when the frame starts. EndFrame() records
+ * input-to-present latency; without a present waiter the latency is measured up to submission instead.
+ */
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+    using PresentWaiter = std::function<bool(uint64_t, std::chrono::nanoseconds)>;
+    // Dispatches events for at most the timeout, returning early once some were handled.
+    using EventWaiter = std::function<void(std::chrono::nanoseconds)>;
+
+    FramePacer(double target_frame_time, uint32_t max_queued_frames, const std::shared_ptr<spdlog::logger>& logger);
+    ~FramePacer() = default;
+
+    FramePacer() = delete;
+    FramePacer(const FramePacer& pacer) = delete;
+    FramePacer& operator=(const FramePacer& pacer) = delete;
+    FramePacer(FramePacer&& pacer) = delete;
+    FramePacer& operator=(FramePacer&& pacer) = delete;
+
+public:
+    void SetTargetFrameTime(double target_frame_time);
+    void SetMaxQueuedFrames(uint32_t max_queued_frames);
+    void SetPresentWaiter(PresentWaiter waiter);
+    void SetEventWaiter(EventWaiter waiter);
+    void BeginFrame();
+    void EndFrame(std::optional<Clock::time_point> input_time);
+    uint64_t PresentId() const;
+    uint32_t MaxQueuedFrames() const;
+    LatencyPercentiles InputLatency() const;
+
+private:
+    void WaitForPresent();
+    void WaitForDeadline();
+    void RecordLatency(Clock::time_point input_time, Clock::time_point present_time);
+
+private:
+    Clock::duration target_frame_time_{0};
+    uint32_t max_queued_frames_{0};
+    PresentWaiter present_waiter_{};
+    EventWaiter event_waiter_{};
+    uint64_t present_id_{0};
+    uint64_t presented_id_{0};
+    Clock::time_point deadline_{};
+    std::deque<std::pair<uint64_t, Clock::time_point>> pending_inputs_{};
+    RollingSamples latencies_{LATENCY_WINDOW_};
+    uint64_t frames_since_report_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+    static constexpr size_t LATENCY_WINDOW_ = 1024;
+    static constexpr uint64_t REPORT_INTERVAL_ = 3600;
+    static constexpr auto SPIN_MARGIN_ = std::chrono::milliseconds(1);
+    static constexpr auto PRESENT_TIMEOUT_ = std::chrono::milliseconds(100);
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_FRAME_PACER_H_
\ No newline at end of file
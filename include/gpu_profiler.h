@@ -0,0 +1,92 @@
+/**
+ * @file gpu_profiler.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_GPU_PROFILER_H_)
+#define SERENITY_GPU_PROFILER_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "device.h"
+#include "spdlog.h"
+#include "statistics.h"
+#include "vulkan/vulkan.h"
+
+namespace serenity {
+
+struct GpuPassStatistics {
+    std::string name{};
+    double last_ms{0.0};
+    double min_ms{0.0};
+    double avg_ms{0.0};
+    double p99_ms{0.0};
+    size_t samples{0};
+};
+
+/**
+ * Brackets render passes and dispatches with timestamp queries. Each frame in flight owns a query pool; BeginFrame()
+ * collects whatever the slot's previous frame left behind without waiting (results that are not yet available are
+ * dropped) and resets the pool, so it must be recorded outside of a render pass.
+ */
+class GpuProfiler {
+public:
+    GpuProfiler(const Device& device, uint32_t frames_in_flight, uint32_t max_passes, const std::shared_ptr<spdlog::logger>& logger);
+    ~GpuProfiler();
+
+    GpuProfiler() = delete;
+    GpuProfiler(const GpuProfiler& profiler) = delete;
+    GpuProfiler& operator=(const GpuProfiler& profiler) = delete;
+    GpuProfiler(GpuProfiler&& profiler) = delete;
+    GpuProfiler& operator=(GpuProfiler&& profiler) = delete;
+
+public:
+    void BeginFrame(VkCommandBuffer command_buffer, uint32_t frame_index);
+    void BeginPass(VkCommandBuffer command_buffer, const std::string& name);
+    void EndPass(VkCommandBuffer command_buffer);
+    std::vector<GpuPassStatistics> Statistics() const;
+    void Report() const;
+
+private:
+    struct Pass {
+        std::string name;
+        uint32_t begin_query;
+        uint32_t end_query;
+    };
+
+    struct Frame {
+        VkQueryPool query_pool = nullptr;
+        uint32_t next_query{0};
+        std::vector<Pass> passes{};
+        std::vector<size_t> open_passes{};
+        uint64_t cpu_ticks{0};
+    };
+
+private:
+    void CollectResults(Frame& frame);
+
+private:
+    const Device& device_;
+    bool enabled_{false};
+    uint32_t query_capacity_{0};
+    uint64_t timestamp_mask_{0};
+    double timestamp_period_{0.0};
+    std::vector<Frame> frames_{};
+    Frame* current_{nullptr};
+    std::map<std::string, RollingSamples> samples_{};
+    std::map<std::string, double> last_{};
+    uint64_t frames_since_report_{0};
+    uint64_t dropped_results_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+    static constexpr size_t SAMPLE_WINDOW_ = 256;
+    static constexpr uint64_t REPORT_INTERVAL_ = 3600;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_GPU_PROFILER_H_
\ No newline at end of file
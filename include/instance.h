@@ -7,6 +7,8 @@
 #if !defined(SERENITY_INSTANCE_H_)
 #define SERENITY_INSTANCE_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -27,6 +29,12 @@ public:
     Instance(Instance&& instance) = delete;
     Instance& operator=(Instance&& instance) = delete;
 
+public:
+    VkInstance Handle() const;
+    bool ValidationLayersEnabled() const;
+    const std::vector<const char*>& ValidationLayers() const;
+    uint64_t ValidationMessages(VkDebugUtilsMessageSeverityFlagBitsEXT severity) const;
+
 private:
     void CreateInstance();
     bool CheckValidationLayerSupport();
@@ -47,6 +55,9 @@ private:
     const bool ENABLE_VALIDATION_LAYERS_ = true;
 #endif  // NODEBUG
     VkDebugUtilsMessengerEXT debug_messenger_ = nullptr;
+    std::atomic<uint64_t> info_messages_{0};
+    std::atomic<uint64_t> warning_messages_{0};
+    std::atomic<uint64_t> error_messages_{0};
 };
 
 }  // namespace serenity
@@ -0,0 +1,85 @@
+/**
+ * @file instance_batcher.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_INSTANCE_BATCHER_H_)
+#define SERENITY_INSTANCE_BATCHER_H_
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "glm.hpp"
+#include "render_queue.h"
+
+namespace serenity {
+
+// One instance as the vertex shader reads it from the per-frame instance buffer.
+struct InstanceData {
+    glm::mat4 transform{1.0F};
+    glm::vec4 parameters{0.0F};
+};
+
+struct DrawDesc {
+    uint32_t mesh{0};
+    InstanceData instance{};
+};
+
+// One draw command: instance_count instances of mesh, read from the instance buffer starting at first_instance.
+struct BatchedDraw {
+    uint64_t key{0};
+    uint32_t mesh{0};
+    uint32_t first_instance{0};
+    uint32_t instance_count{1};
+};
+
+struct BatchStats {
+    uint64_t draws{0};
+    uint64_t commands{0};
+    uint64_t instanced_commands{0};
+    uint64_t draws_saved{0};
+};
+
+/**
+ * Collapses draws from a sorted RenderQueue that share pass, pipeline, material and mesh into instanced draws, so
+ * forests, crowds and debris cost a handful of draw commands without being instanced by hand. Groups smaller than
+ * the threshold stay one command per draw. Every draw's InstanceData is written exactly once, in command order,
+ * straight into the caller's instance buffer, which is usually the mapped per-frame buffer. Passes marked ordered,
+ * such as blended ones sorted back to front, keep the queue's draw order and only merge consecutive draws of a mesh.
+ */
+class InstanceBatcher {
+public:
+    explicit InstanceBatcher(uint32_t threshold = 2);
+    ~InstanceBatcher() = default;
+
+    InstanceBatcher(const InstanceBatcher& batcher) = delete;
+    InstanceBatcher& operator=(const InstanceBatcher& batcher) = delete;
+    InstanceBatcher(InstanceBatcher&& batcher) = delete;
+    InstanceBatcher& operator=(InstanceBatcher&& batcher) = delete;
+
+public:
+    void SetThreshold(uint32_t threshold);
+    uint32_t Threshold() const;
+    // Passes are the DrawKey pass field; none is ordered by default.
+    void SetOrdered(uint32_t pass, bool ordered);
+    bool Ordered(uint32_t pass) const;
+    // Items in the queue index draws. Throws if the instance buffer holds fewer than queue.Size() instances.
+    const std::vector<BatchedDraw>& Build(const RenderQueue& queue, const std::vector<DrawDesc>& draws, InstanceData* instances, size_t capacity);
+    const std::vector<BatchedDraw>& Draws() const;
+    const BatchStats& Stats() const;
+    void Clear();
+
+private:
+    uint32_t threshold_;
+    std::bitset<size_t{1} << DrawKey::PASS_BITS> ordered_{};
+    std::vector<BatchedDraw> commands_{};
+    std::vector<uint32_t> group_{};
+    BatchStats stats_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_INSTANCE_BATCHER_H_
\ No newline at end of file
@@ -0,0 +1,89 @@
+/**
+ * @file lod_selector.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_LOD_SELECTOR_H_)
+#define SERENITY_LOD_SELECTOR_H_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "glm.hpp"
+#include "mesh_simplifier.h"
+
+namespace serenity {
+
+constexpr uint32_t NO_LOD = std::numeric_limits<uint32_t>::max();
+
+struct LodSettings {
+    // Largest projected geometric error, in pixels, a level may show.
+    float pixel_error{1.0F};
+    // A coarser level is only taken once its error is this fraction below pixel_error, so objects sitting at a
+    // switching distance do not flip every frame.
+    float hysteresis{0.25F};
+    // Seconds a switch cross-fades over; zero switches at once.
+    float fade_time{0.0F};
+};
+
+// Per-instance selection state, owned by whoever owns the instance.
+struct LodState {
+    uint32_t level{0};
+    uint32_t previous{NO_LOD};
+    float fade{1.0F};
+};
+
+/**
+ * What to draw: level, plus previous while a cross-fade runs. Both are drawn with complementary dither masks, so
+ * each pixel shows exactly one of them and no blending or sorting is needed; see DitherVisible.
+ */
+struct LodSelection {
+    uint32_t level{0};
+    uint32_t previous{NO_LOD};
+    float fade{1.0F};
+
+    bool Fading() const {
+        return previous != NO_LOD;
+    }
+};
+
+/**
+ * Picks LODs by projected screen-space error: a level's geometric error, scaled to world units, divided by the
+ * distance to the instance's bounding sphere and multiplied by the pixels per unit at distance one. The coarsest
+ * level within the pixel budget wins.
+ */
+class LodSelector {
+public:
+    explicit LodSelector(const LodSettings& settings = {});
+    ~LodSelector() = default;
+
+    LodSelector(const LodSelector& selector) = delete;
+    LodSelector& operator=(const LodSelector& selector) = delete;
+    LodSelector(LodSelector&& selector) = delete;
+    LodSelector& operator=(LodSelector&& selector) = delete;
+
+public:
+    void SetSettings(const LodSettings& settings);
+    const LodSettings& Settings() const;
+    // Once per frame; fovy is the vertical field of view in radians.
+    void SetView(const glm::vec3& camera, float fovy, float viewport_height);
+    // Infinite when the camera is inside the sphere.
+    float ProjectedError(float error, const glm::vec3& center, float radius) const;
+    // Levels as GenerateLods produced them; scale converts their errors to world units. Advances state by dt seconds.
+    LodSelection Select(const std::vector<LodLevel>& levels, const glm::vec3& center, float radius, float scale, LodState& state, float dt) const;
+
+    // The ordered 4x4 dither a cross-fade uses: the incoming level covers pixel (x, y) when this is true, the
+    // outgoing level when it is false.
+    static bool DitherVisible(float fade, uint32_t x, uint32_t y);
+
+private:
+    LodSettings settings_;
+    glm::vec3 camera_{0.0F};
+    float pixels_per_unit_{1.0F};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_LOD_SELECTOR_H_
\ No newline at end of file
@@ -0,0 +1,48 @@
+/**
+ * @file mesh.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_MESH_H_)
+#define SERENITY_MESH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bounds.h"
+#include "glm.hpp"
+
+namespace serenity {
+
+/**
+ * Indexed triangle list as the asset pipeline handles it, before any vertex compression. Normals are required;
+ * tangents (xyz, with the bitangent sign in w) and UVs are optional but, when present, have one entry per position.
+ */
+struct Mesh {
+    std::vector<glm::vec3> positions{};
+    std::vector<glm::vec3> normals{};
+    std::vector<glm::vec4> tangents{};
+    std::vector<glm::vec2> uvs{};
+    std::vector<uint32_t> indices{};
+
+    size_t VertexCount() const {
+        return positions.size();
+    }
+    size_t TriangleCount() const {
+        return indices.size() / 3;
+    }
+    Aabb Bounds() const;
+    // Throws when attribute arrays disagree in length or an index is out of range.
+    void Validate() const;
+
+    // UV sphere with tangents, for tests and benchmarks.
+    static Mesh Sphere(uint32_t rings, uint32_t segments, float radius);
+    // Square grid in the xz plane with a rolling height field, for tests and benchmarks.
+    static Mesh Terrain(uint32_t cells, float size, float height);
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_MESH_H_
\ No newline at end of file
@@ -0,0 +1,61 @@
+/**
+ * @file mesh_simplifier.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_MESH_SIMPLIFIER_H_)
+#define SERENITY_MESH_SIMPLIFIER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "mesh.h"
+
+namespace serenity {
+
+struct SimplifyResult {
+    std::vector<uint32_t> indices{};
+    // Geometric error in mesh units: the area-weighted RMS distance from collapsed vertices to the planes of the
+    // triangles they absorbed, at the worst collapse.
+    float error{0.0F};
+};
+
+// One level of a LodChain: a range of the chain's index buffer.
+struct LodLevel {
+    uint32_t first_index{0};
+    uint32_t index_count{0};
+    float error{0.0F};
+};
+
+// Levels share the vertex buffer and store their indices back to back in mesh.indices, finest first; errors never
+// decrease from one level to the next.
+struct LodChain {
+    Mesh mesh{};
+    std::vector<LodLevel> levels{};
+};
+
+struct LodOptions {
+    uint32_t max_levels{6};
+    // Each level aims for this fraction of the previous level's triangles.
+    float reduction{0.5F};
+    uint32_t min_triangles{64};
+    // Geometric error in mesh units beyond which no collapse is made.
+    float max_error{std::numeric_limits<float>::infinity()};
+};
+
+/**
+ * Quadric error edge collapse down to target_index_count indices, stopping early rather than exceed max_error.
+ * Vertices collapse onto a neighbour, so attributes never need interpolating; vertices on open borders and
+ * attribute seams stay put, and collapses that would flip a triangle are skipped. Deterministic.
+ */
+SimplifyResult Simplify(const Mesh& mesh, size_t target_index_count, float max_error = std::numeric_limits<float>::infinity());
+// Import-time LOD chain; level 0 is the mesh as given, each coarser level is simplified from the previous one and
+// cache-optimized. Stops early when a level no longer shrinks meaningfully.
+LodChain GenerateLods(const Mesh& mesh, const LodOptions& options = {});
+
+}  // namespace serenity
+
+#endif  // SERENITY_MESH_SIMPLIFIER_H_
\ No newline at end of file
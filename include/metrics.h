@@ -0,0 +1,140 @@
+/**
+ * @file metrics.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_METRICS_H_)
+#define SERENITY_METRICS_H_
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serenity {
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+public:
+    Counter() = default;
+    ~Counter() = default;
+
+    Counter(const Counter& counter) = delete;
+    Counter& operator=(const Counter& counter) = delete;
+    Counter(Counter&& counter) = delete;
+    Counter& operator=(Counter&& counter) = delete;
+
+public:
+    void Increment(uint64_t amount = 1);
+    uint64_t Value() const;
+
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+class Gauge {
+public:
+    Gauge() = default;
+    ~Gauge() = default;
+
+    Gauge(const Gauge& gauge) = delete;
+    Gauge& operator=(const Gauge& gauge) = delete;
+    Gauge(Gauge&& gauge) = delete;
+    Gauge& operator=(Gauge&& gauge) = delete;
+
+public:
+    void Set(double value);
+    double Value() const;
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+class Histogram {
+public:
+    explicit Histogram(std::vector<double> bounds);
+    ~Histogram() = default;
+
+    Histogram() = delete;
+    Histogram(const Histogram& histogram) = delete;
+    Histogram& operator=(const Histogram& histogram) = delete;
+    Histogram(Histogram&& histogram) = delete;
+    Histogram& operator=(Histogram&& histogram) = delete;
+
+public:
+    void Observe(double value);
+    const std::vector<double>& Bounds() const;
+    std::vector<uint64_t> CumulativeCounts() const;
+    double Sum() const;
+
+private:
+    std::vector<double> bounds_;
+    std::unique_ptr<std::atomic<uint64_t>[]> counts_;
+    std::atomic<double> sum_{0.0};
+};
+
+/**
+ * Counters, gauges and histograms rendered in the Prometheus text exposition format. Adding a series that already
+ * exists returns it, so code that only wants to bump a well-known counter can add it where it is used. Updates are
+ * lock-free; the registry lock is only taken to add series and to render. Callback series are sampled on render,
+ * which happens on the scraping thread.
+ */
+class MetricsRegistry {
+public:
+    using Sampler = std::function<double()>;
+
+    MetricsRegistry() = default;
+    ~MetricsRegistry() = default;
+
+    MetricsRegistry(const MetricsRegistry& registry) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry& registry) = delete;
+    MetricsRegistry(MetricsRegistry&& registry) = delete;
+    MetricsRegistry& operator=(MetricsRegistry&& registry) = delete;
+
+public:
+    Counter& AddCounter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& AddGauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Histogram& AddHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds, const MetricLabels& labels = {});
+    void AddCounterCallback(const std::string& name, const std::string& help, const MetricLabels& labels, Sampler sampler);
+    void AddGaugeCallback(const std::string& name, const std::string& help, const MetricLabels& labels, Sampler sampler);
+    std::string Render() const;
+
+private:
+    enum class Type {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM,
+    };
+
+    struct Series {
+        MetricLabels labels;
+        std::unique_ptr<Counter> counter{};
+        std::unique_ptr<Gauge> gauge{};
+        std::unique_ptr<Histogram> histogram{};
+        Sampler sampler{};
+    };
+
+    struct Family {
+        Type type;
+        std::string help;
+        std::vector<std::unique_ptr<Series>> series{};
+    };
+
+private:
+    Series& FindOrAdd(const std::string& name, const std::string& help, Type type, const MetricLabels& labels);
+
+private:
+    mutable std::mutex mutex_{};
+    std::map<std::string, Family> families_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_METRICS_H_
\ No newline at end of file
@@ -0,0 +1,49 @@
+/**
+ * @file metrics_server.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_METRICS_SERVER_H_)
+#define SERENITY_METRICS_SERVER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "metrics.h"
+#include "spdlog.h"
+
+namespace serenity {
+
+/**
+ * Serves the registry as Prometheus text on http://127.0.0.1:<port>/metrics from a background thread. It only binds
+ * the loopback interface and answers one request per connection, which is all a scraper needs.
+ */
+class MetricsServer {
+public:
+    MetricsServer(const MetricsRegistry& registry, uint16_t port, const std::shared_ptr<spdlog::logger>& logger);
+    ~MetricsServer();
+
+    MetricsServer() = delete;
+    MetricsServer(const MetricsServer& server) = delete;
+    MetricsServer& operator=(const MetricsServer& server) = delete;
+    MetricsServer(MetricsServer&& server) = delete;
+    MetricsServer& operator=(MetricsServer&& server) = delete;
+
+private:
+    void Serve();
+    void Respond(std::uintptr_t client);
+
+private:
+    const MetricsRegistry& registry_;
+    std::uintptr_t listener_;
+    std::atomic<bool> running_{true};
+    std::thread thread_{};
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_METRICS_SERVER_H_
\ No newline at end of file
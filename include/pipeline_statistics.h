@@ -0,0 +1,116 @@
+/**
+ * @file pipeline_statistics.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_PIPELINE_STATISTICS_H_)
+#define SERENITY_PIPELINE_STATISTICS_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "device.h"
+#include "spdlog.h"
+#include "vulkan/vulkan.h"
+
+namespace serenity {
+
+struct PipelineCounters {
+    uint64_t input_vertices{0};
+    uint64_t input_primitives{0};
+    uint64_t vertex_invocations{0};
+    uint64_t clipping_invocations{0};
+    uint64_t clipping_primitives{0};
+    uint64_t fragment_invocations{0};
+    uint64_t compute_invocations{0};
+    uint64_t samples_passed{0};
+
+    PipelineCounters& operator+=(const PipelineCounters& counters);
+};
+
+struct PipelineStatisticsEntry {
+    std::string pass{};
+    std::string bucket{};
+    uint64_t frames{0};
+    PipelineCounters per_frame{};
+    double overdraw{0.0};
+    double culled_primitives{0.0};
+    double depth_rejected_fragments{0.0};
+};
+
+/**
+ * Opt-in instrumentation that wraps passes in pipeline statistics and occlusion queries, one pool of each per frame
+ * in flight. Results are read back without waiting and accumulated per pass and per (pass, material bucket); an
+ * empty bucket is the whole pass. Queries of one type cannot nest, so a BeginPass() while a pass is open, and the
+ * EndPass() matching it, are ignored and the outer pass keeps counting. Overdraw is fragment invocations per render
+ * target pixel and needs SetTargetExtent().
+ */
+class PipelineStatistics {
+public:
+    PipelineStatistics(const Device& device, uint32_t frames_in_flight, uint32_t max_passes, const std::shared_ptr<spdlog::logger>& logger);
+    ~PipelineStatistics();
+
+    PipelineStatistics() = delete;
+    PipelineStatistics(const PipelineStatistics& statistics) = delete;
+    PipelineStatistics& operator=(const PipelineStatistics& statistics) = delete;
+    PipelineStatistics(PipelineStatistics&& statistics) = delete;
+    PipelineStatistics& operator=(PipelineStatistics&& statistics) = delete;
+
+public:
+    bool Enabled() const;
+    void SetTargetExtent(uint32_t width, uint32_t height);
+    void BeginFrame(VkCommandBuffer command_buffer, uint32_t frame_index);
+    void BeginPass(VkCommandBuffer command_buffer, const std::string& pass, const std::string& bucket);
+    void EndPass(VkCommandBuffer command_buffer);
+    std::vector<PipelineStatisticsEntry> Statistics() const;
+    void Report();
+
+private:
+    struct Query {
+        std::string pass;
+        std::string bucket;
+    };
+
+    struct Frame {
+        VkQueryPool statistics_pool = nullptr;
+        VkQueryPool occlusion_pool = nullptr;
+        std::vector<Query> queries{};
+        bool open{false};
+    };
+
+    struct Totals {
+        uint64_t frames{0};
+        uint64_t last_frame{~uint64_t{0}};
+        PipelineCounters counters{};
+    };
+
+private:
+    void CollectResults(Frame& frame);
+
+private:
+    const Device& device_;
+    bool enabled_{false};
+    uint32_t max_passes_{0};
+    VkQueryControlFlags occlusion_flags_{0};
+    uint64_t target_pixels_{0};
+    uint64_t frame_count_{0};
+    std::vector<Frame> frames_{};
+    Frame* current_{nullptr};
+    std::vector<bool> labels_{};
+    // Per open BeginPass(), whether it began the queries.
+    std::vector<bool> opened_{};
+    std::map<std::pair<std::string, std::string>, Totals> totals_{};
+    uint64_t frames_since_report_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+    static constexpr uint32_t COUNTERS_ = 7;
+    static constexpr uint64_t REPORT_INTERVAL_ = 3600;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_PIPELINE_STATISTICS_H_
\ No newline at end of file
@@ -0,0 +1,19 @@
+/**
+ * @file process_stats.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_PROCESS_STATS_H_)
+#define SERENITY_PROCESS_STATS_H_
+
+#include <cstdint>
+
+namespace serenity {
+
+uint64_t PeakResidentBytes();
+uint64_t CurrentResidentBytes();
+
+}  // namespace serenity
+
+#endif  // SERENITY_PROCESS_STATS_H_
\ No newline at end of file
@@ -0,0 +1,92 @@
+/**
+ * @file render_queue.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_RENDER_QUEUE_H_)
+#define SERENITY_RENDER_QUEUE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "thread_pool.h"
+
+namespace serenity {
+
+/**
+ * Fields of a draw's 64-bit sort key, most significant first: pass, pipeline, material, depth bucket. Sorting the
+ * packed keys groups draws by pass, then pipeline, then material, which is the order in which changing state costs
+ * the most, and orders the draws sharing all three by depth.
+ */
+struct DrawKey {
+    static constexpr uint32_t PASS_BITS = 8;
+    static constexpr uint32_t PIPELINE_BITS = 16;
+    static constexpr uint32_t MATERIAL_BITS = 24;
+    static constexpr uint32_t DEPTH_BITS = 16;
+
+    uint32_t pass{0};
+    uint32_t pipeline{0};
+    uint32_t material{0};
+    uint32_t depth{0};
+
+    // Fields wider than their bits are truncated.
+    uint64_t Pack() const;
+    static DrawKey Unpack(uint64_t key);
+    // Quantizes view depth between near and far. Opaque passes sort front to back to help early depth rejection;
+    // blended ones need back to front.
+    static uint32_t DepthBucket(float depth, float near_plane, float far_plane, bool back_to_front = false);
+};
+
+struct DrawItem {
+    uint64_t key{0};
+    // Index of the draw in the caller's own draw list.
+    uint32_t draw{0};
+};
+
+// State changes recording the queue in its current order costs.
+struct RenderQueueStats {
+    uint64_t items{0};
+    uint64_t passes{0};
+    uint64_t pipeline_binds{0};
+    uint64_t material_binds{0};
+};
+
+/**
+ * Draws gathered for one frame. Sort() orders them by key with a stable parallel LSD radix sort, eight bits per pass,
+ * skipping digits that are the same for every key, so command recording can walk Items() and bind only what changed.
+ * Push() is not thread-safe; gather per thread and Append() the results.
+ */
+class RenderQueue {
+public:
+    static constexpr uint32_t RADIX_BITS = 8;
+    // Items per block handed to the thread pool.
+    static constexpr size_t SORT_BLOCK = 16384;
+
+    RenderQueue() = default;
+    ~RenderQueue() = default;
+
+    RenderQueue(const RenderQueue& queue) = delete;
+    RenderQueue& operator=(const RenderQueue& queue) = delete;
+    RenderQueue(RenderQueue&& queue) = delete;
+    RenderQueue& operator=(RenderQueue&& queue) = delete;
+
+public:
+    void Push(const DrawKey& key, uint32_t draw);
+    void Push(uint64_t key, uint32_t draw);
+    void Append(const std::vector<DrawItem>& items);
+    void Clear();
+    size_t Size() const;
+    void Sort(ThreadPool& pool);
+    const std::vector<DrawItem>& Items() const;
+    RenderQueueStats Stats() const;
+
+private:
+    std::vector<DrawItem> items_{};
+    std::vector<DrawItem> scratch_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_RENDER_QUEUE_H_
\ No newline at end of file
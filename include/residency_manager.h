@@ -0,0 +1,110 @@
+/**
+ * @file residency_manager.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_RESIDENCY_MANAGER_H_)
+#define SERENITY_RESIDENCY_MANAGER_H_
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "device.h"
+#include "spdlog.h"
+#include "vulkan/vulkan.h"
+
+namespace serenity {
+
+enum class ResourceCategory {
+    TEXTURE,
+    GEOMETRY,
+    RENDER_TARGET,
+    STAGING,
+};
+
+constexpr size_t RESOURCE_CATEGORY_COUNT = 4;
+
+const char* ResourceCategoryName(ResourceCategory category);
+
+struct HeapUsage {
+    uint32_t heap_index{0};
+    bool device_local{false};
+    VkDeviceSize size{0};
+    VkDeviceSize budget{0};
+    VkDeviceSize usage{0};
+    std::array<VkDeviceSize, RESOURCE_CATEGORY_COUNT> categories{};
+    // Past the budget fraction with nothing left to evict, as of the last Tick().
+    bool over_budget{false};
+};
+
+/**
+ * Tracks GPU allocations per memory heap and category against the driver's budget. Budgets come from
+ * VK_EXT_memory_budget when enabled and from a fixed share of the heap size otherwise. Tick() once per frame refreshes
+ * the budget and, when a heap passes the configured fraction of it, calls the evict callbacks of its lowest priority
+ * resources until it is back under; a heap that stays over is reported once when it goes over and once when it
+ * recovers, not every frame. An evict callback frees or downgrades its resource and returns the bytes released;
+ * it runs under the manager's lock and must not call back into it. Priorities are in [0, 1] as in VK_EXT_memory_priority.
+ */
+class ResidencyManager {
+public:
+    using ResourceId = uint64_t;
+    using EvictCallback = std::function<VkDeviceSize()>;
+
+    ResidencyManager(const Device& device, double budget_fraction, const std::shared_ptr<spdlog::logger>& logger);
+    ~ResidencyManager() = default;
+
+    ResidencyManager() = delete;
+    ResidencyManager(const ResidencyManager& manager) = delete;
+    ResidencyManager& operator=(const ResidencyManager& manager) = delete;
+    ResidencyManager(ResidencyManager&& manager) = delete;
+    ResidencyManager& operator=(ResidencyManager&& manager) = delete;
+
+public:
+    ResourceId Register(ResourceCategory category, uint32_t memory_type_index, VkDeviceSize size, float priority, VkDeviceMemory memory, EvictCallback evict);
+    void Unregister(ResourceId id);
+    void Resize(ResourceId id, VkDeviceSize size);
+    void SetPriority(ResourceId id, float priority);
+    void SetBudgetFraction(double budget_fraction);
+    void Tick();
+    std::vector<HeapUsage> Heaps() const;
+    uint64_t Evictions() const;
+
+private:
+    struct Resource {
+        ResourceCategory category;
+        uint32_t heap_index;
+        VkDeviceSize size;
+        float priority;
+        VkDeviceMemory memory;
+        EvictCallback evict;
+    };
+
+private:
+    void QueryBudget();
+    // Returns whether the heap got back within the limit.
+    bool Evict(HeapUsage& heap, VkDeviceSize limit);
+
+private:
+    const Device& device_;
+    double budget_fraction_;
+    VkPhysicalDeviceMemoryProperties memory_properties_{};
+    PFN_vkGetPhysicalDeviceMemoryProperties2KHR get_memory_properties2_{nullptr};
+    PFN_vkSetDeviceMemoryPriorityEXT set_memory_priority_{nullptr};
+    mutable std::mutex mutex_{};
+    std::vector<HeapUsage> heaps_{};
+    std::unordered_map<ResourceId, Resource> resources_{};
+    ResourceId next_id_{1};
+    uint64_t evictions_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+    static constexpr double FALLBACK_BUDGET_SHARE_ = 0.8;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_RESIDENCY_MANAGER_H_
\ No newline at end of file
@@ -0,0 +1,73 @@
+/**
+ * @file scene_loader.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_SCENE_LOADER_H_)
+#define SERENITY_SCENE_LOADER_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+#include "glm.hpp"
+#include "gtc/quaternion.hpp"
+
+namespace serenity {
+
+struct AssetDesc {
+    std::string id{};
+    std::string path{};
+    std::string type{};
+};
+
+struct EntityDesc {
+    std::string name{};
+    std::string mesh{};
+    std::string material{};
+    glm::vec3 position{0.0F};
+    glm::quat rotation{1.0F, 0.0F, 0.0F, 0.0F};
+    glm::vec3 scale{1.0F};
+    int64_t parent{-1};
+};
+
+struct SceneLoadStats {
+    uint64_t assets{0};
+    uint64_t entities{0};
+    uint64_t skipped_values{0};
+};
+
+/**
+ * Streams scene files and asset manifests through nlohmann's SAX interface, so memory stays bounded by one
+ * entity no matter how large the file is. A file is an object with an optional "assets" array of
+ * {"id", "path", "type"} and an optional "entities" array of {"name", "mesh", "material", "position": [x, y, z],
+ * "rotation": [x, y, z, w], "scale": [x, y, z], "parent": index}; a manifest is a scene without entities.
+ * Unknown keys are skipped, and parents refer to entities by their index in file order.
+ */
+class SceneLoader {
+public:
+    using AssetCallback = std::function<void(const AssetDesc&)>;
+    using EntityCallback = std::function<void(const EntityDesc&)>;
+
+    SceneLoader(AssetCallback on_asset, EntityCallback on_entity);
+    ~SceneLoader() = default;
+
+    SceneLoader() = delete;
+    SceneLoader(const SceneLoader& loader) = delete;
+    SceneLoader& operator=(const SceneLoader& loader) = delete;
+    SceneLoader(SceneLoader&& loader) = delete;
+    SceneLoader& operator=(SceneLoader&& loader) = delete;
+
+public:
+    SceneLoadStats Load(const std::filesystem::path& path);
+
+private:
+    AssetCallback on_asset_;
+    EntityCallback on_entity_;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_SCENE_LOADER_H_
\ No newline at end of file
@@ -7,28 +7,141 @@
 #if !defined(SERENITY_SERENITY_H_)
 #define SERENITY_SERENITY_H_
 
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <functional>
 #include <memory>
+#include <vector>
 
+#include "bvh.h"
+#include "config.h"
+#include "device.h"
+#include "ecs.h"
+#include "frame_pacer.h"
+#include "gpu_profiler.h"
 #include "instance.h"
-#include "json.hpp"
+#include "instance_batcher.h"
+#include "lod_selector.h"
+#include "metrics.h"
+#include "metrics_server.h"
+#include "pipeline_statistics.h"
+#include "render_queue.h"
+#include "residency_manager.h"
+#include "simulation.h"
+#include "spatial_hash_grid.h"
 #include "spdlog.h"
+#include "spdlog/sinks/dist_sink.h"
+#include "startup.h"
+#include "state_buffer.h"
+#include "thread_pool.h"
+#include "transform_hierarchy.h"
 #include "window.h"
 
 namespace serenity {
 
+// What the simulation hands the renderer after every tick.
+struct SimulationState {
+    uint64_t tick{0};
+    Simulation::Clock::time_point time{};
+    // TransformHierarchy::Generation() world reflects; slots are brought up to date from it.
+    uint64_t generation{0};
+    // World matrices as of this tick, indexed by NodeId; identity for unused ids.
+    std::vector<glm::mat4> world{};
+};
+
 class Serenity {
 public:
-    Serenity();
+    // Cell edge of DynamicBounds(), in world units; about the size of the objects it holds.
+    static constexpr float DYNAMIC_CELL_SIZE = 16.0F;
+
+    explicit Serenity(const std::filesystem::path& config_path = "serenity.json");
     ~Serenity() = default;
 
 public:
+    // Runs on the simulation thread, which owns Scene() and Transforms() while Loop() runs.
+    using UpdateCallback = std::function<void(double dt)>;
+    // Runs on the main thread with the last two published states; draw previous blended towards current by alpha.
+    // It must not touch Scene() or Transforms(), which the simulation thread may be writing.
+    using RenderCallback = std::function<void(const SimulationState& previous, const SimulationState& current, double alpha)>;
+
     void Loop();
+    void Frame();
+    void SetUpdateCallback(UpdateCallback update);
+    void SetRenderCallback(RenderCallback render);
+    void SetContinuousRendering(bool continuous);
+    void RequestRedraw();
+    const std::vector<StageTiming>& StartupTimings() const;
+    const std::array<float, 4>& ClearColor() const;
+    GpuProfiler& Profiler();
+    const Device& GetDevice() const;
+    PipelineStatistics* PipelineStats();
+    ResidencyManager& Residency();
+    MetricsRegistry& Metrics();
+    ThreadPool& Workers();
+    World& Scene();
+    TransformHierarchy& Transforms();
+    // Bounds of the static scene, indexed however the update callback builds them. Owned by the simulation thread
+    // like Scene(), so it is queried from the update callback too; every tick that updated it refits it afterwards.
+    Bvh& StaticBounds();
+    // Objects that move every tick, where refitting the BVH would degrade it. Owned by the simulation thread the same
+    // way, and re-sorted after every tick that moved one into another bucket.
+    SpatialHashGrid& DynamicBounds();
+    // Filled, sorted and batched by the render callback; Frame() reports their stats and clears both afterwards.
+    RenderQueue& Queue();
+    InstanceBatcher& Batcher();
+    // Follows the lod_* settings; the render callback sets the view each frame and selects per instance.
+    LodSelector& Lods();
+
+private:
+    void CreateLogger();
+    void CreateSimulation();
+    void StartSimulation();
+    void PublishState(Simulation::Clock::time_point time);
+    void RegisterMetrics();
+    void CreateMetricsServer(uint32_t port);
+    void ApplyConfig(const Settings& previous, const Settings& current);
 
 private:
-    nlohmann::json config_;
+    MetricsRegistry metrics_{};
+    std::unique_ptr<Config> config_;
+    std::shared_ptr<spdlog::sinks::dist_sink_mt> log_sink_;
     std::shared_ptr<spdlog::logger> logger_;
     std::unique_ptr<Window> window_;
     std::unique_ptr<Instance> instance_;
+    std::unique_ptr<Device> device_;
+    std::unique_ptr<GpuProfiler> gpu_profiler_;
+    std::unique_ptr<PipelineStatistics> pipeline_statistics_;
+    std::unique_ptr<ResidencyManager> residency_;
+    std::unique_ptr<Simulation> simulation_;
+    std::unique_ptr<FramePacer> frame_pacer_;
+    std::unique_ptr<ThreadPool> thread_pool_;
+    World world_{};
+    TransformHierarchy transforms_{};
+    Bvh static_bounds_{};
+    SpatialHashGrid dynamic_bounds_{DYNAMIC_CELL_SIZE};
+    RenderQueue render_queue_{};
+    InstanceBatcher instance_batcher_{};
+    LodSelector lod_selector_{};
+    StateBuffer<SimulationState> states_{};
+    uint64_t published_ticks_{0};
+    UpdateCallback update_{};
+    RenderCallback render_{};
+    std::atomic<bool> continuous_rendering_{false};
+    double idle_wait_timeout_{0.0};
+    std::atomic<bool> redraw_requested_{true};
+    bool simulating_{false};
+    std::array<float, 4> clear_color_{};
+    std::vector<StageTiming> startup_timings_{};
+    Counter* frames_{nullptr};
+    Histogram* frame_time_{nullptr};
+    Gauge* draw_items_{nullptr};
+    Gauge* pipeline_binds_{nullptr};
+    Gauge* material_binds_{nullptr};
+    Gauge* draws_saved_{nullptr};
+    Gauge* bvh_degradation_{nullptr};
+    Gauge* grid_objects_{nullptr};
+    std::unique_ptr<MetricsServer> metrics_server_;
 };
 
 }  // namespace serenity
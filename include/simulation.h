@@ -0,0 +1,69 @@
+/**
+ * @file simulation.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_SIMULATION_H_)
+#define SERENITY_SIMULATION_H_
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "spdlog.h"
+
+namespace serenity {
+
+/**
+ * Fixed-timestep simulation running on its own thread, so a slow frame never holds back the simulation and a slow
+ * tick never blocks a frame. Each tick is told the time its resulting state stands for; the tick publishes that state
+ * (see StateBuffer) and the renderer interpolates between the last two with Alpha().
+ */
+class Simulation {
+public:
+    using Clock = std::chrono::steady_clock;
+    // Tick length in seconds, and the time the state after this tick stands for.
+    using TickCallback = std::function<void(double, Clock::time_point)>;
+
+    Simulation(double tick_rate, uint32_t max_ticks_per_update, const std::shared_ptr<spdlog::logger>& logger);
+    ~Simulation();
+
+    Simulation() = delete;
+    Simulation(const Simulation& simulation) = delete;
+    Simulation& operator=(const Simulation& simulation) = delete;
+    Simulation(Simulation&& simulation) = delete;
+    Simulation& operator=(Simulation&& simulation) = delete;
+
+public:
+    void Start(TickCallback tick);
+    void Stop();
+    // How far the present is from a state at state_time towards the next one, in [0, 1].
+    double Alpha(Clock::time_point state_time) const;
+    double TickDuration() const;
+    uint64_t Ticks() const;
+
+private:
+    void Run();
+
+private:
+    Clock::duration tick_duration_;
+    uint32_t max_ticks_per_update_{0};
+    TickCallback tick_{};
+    std::thread thread_{};
+    std::mutex mutex_{};
+    std::condition_variable wake_{};
+    bool running_{false};
+    std::atomic<uint64_t> ticks_{0};
+    std::atomic<uint64_t> dropped_ticks_{0};
+    std::shared_ptr<spdlog::logger> logger_;
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_SIMULATION_H_
\ No newline at end of file
@@ -0,0 +1,98 @@
+/**
+ * @file spatial_hash_grid.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_SPATIAL_HASH_GRID_H_)
+#define SERENITY_SPATIAL_HASH_GRID_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "bounds.h"
+#include "glm.hpp"
+#include "thread_pool.h"
+
+namespace serenity {
+
+using GridObjectId = uint32_t;
+
+/**
+ * Loose uniform grid over an unbounded world for objects that move every frame, where refitting a BVH degrades it.
+ * Objects are spheres filed under the cell holding their center; queries widen their range by the largest radius
+ * instead of inserting an object into every cell it touches. Cells are hashed into a power-of-two bucket table, and
+ * each bucket is a linked list, so Insert(), Move() and Remove() are O(1). Rebuild() re-sorts the objects by bucket
+ * with a parallel counting sort so list walks become linear again. Queries match the Bvh ones: they append object
+ * ids, and may run concurrently with each other but not with changes.
+ */
+class SpatialHashGrid {
+public:
+    explicit SpatialHashGrid(float cell_size);
+    ~SpatialHashGrid() = default;
+
+    SpatialHashGrid() = delete;
+    SpatialHashGrid(const SpatialHashGrid& grid) = delete;
+    SpatialHashGrid& operator=(const SpatialHashGrid& grid) = delete;
+    SpatialHashGrid(SpatialHashGrid&& grid) = delete;
+    SpatialHashGrid& operator=(SpatialHashGrid&& grid) = delete;
+
+public:
+    GridObjectId Insert(const glm::vec3& position, float radius);
+    void Move(GridObjectId object, const glm::vec3& position);
+    void Remove(GridObjectId object);
+    bool Alive(GridObjectId object) const;
+    const glm::vec3& Position(GridObjectId object) const;
+    float Radius(GridObjectId object) const;
+    size_t Size() const;
+    size_t BucketCount() const;
+    float CellSize() const;
+    void Rebuild(ThreadPool& pool);
+    // True once an object has been linked into a bucket out of order since the last Rebuild().
+    bool NeedsRebuild() const;
+
+    void Overlap(const Aabb& box, std::vector<GridObjectId>& objects) const;
+    void Nearby(const glm::vec3& center, float radius, std::vector<GridObjectId>& objects) const;
+    void Cull(const Frustum& frustum, std::vector<GridObjectId>& objects) const;
+
+private:
+    static constexpr uint32_t NONE = ~uint32_t{0};
+
+private:
+    glm::ivec3 CellOf(const glm::vec3& position) const;
+    uint32_t BucketOf(const glm::ivec3& cell) const;
+    uint32_t SlotOf(GridObjectId object) const;
+    void Link(uint32_t slot);
+    void Unlink(uint32_t slot);
+    void Rehash(size_t buckets);
+    // Calls visit(cell) for every cell the box touches, or returns false without visiting when there are more such
+    // cells than buckets and a linear scan over the objects is cheaper.
+    template <typename F>
+    bool VisitCells(const Aabb& box, F&& visit) const;
+    template <typename F>
+    void VisitObjects(const glm::ivec3& cell, F&& visit) const;
+
+private:
+    float cell_size_;
+    float inverse_cell_size_;
+    float max_radius_{0.0F};
+    bool relinked_{false};
+    // Per object slot; slots are dense and reordered by Rebuild().
+    std::vector<glm::vec3> positions_{};
+    std::vector<float> radii_{};
+    std::vector<glm::ivec3> cells_{};
+    std::vector<uint32_t> buckets_{};
+    std::vector<uint32_t> next_{};
+    std::vector<uint32_t> previous_{};
+    std::vector<GridObjectId> ids_{};
+    // Per bucket.
+    std::vector<uint32_t> heads_{};
+    // Per GridObjectId.
+    std::vector<uint32_t> slots_{};
+    std::vector<GridObjectId> free_ids_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_SPATIAL_HASH_GRID_H_
\ No newline at end of file
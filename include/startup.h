@@ -0,0 +1,70 @@
+/**
+ * @file startup.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_STARTUP_H_)
+#define SERENITY_STARTUP_H_
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "spdlog.h"
+
+namespace serenity {
+
+struct StageTiming {
+    std::string name;
+    std::chrono::nanoseconds start{0};
+    std::chrono::nanoseconds duration{0};
+    bool main_thread{false};
+};
+
+/**
+ * Runs the engine startup as a graph of named stages. Stages whose dependencies are satisfied run concurrently;
+ * stages pinned to the main thread (GLFW window creation, for example) run on the thread calling Run().
+ * Dependencies must be registered before the stages that use them.
+ */
+class Startup {
+public:
+    enum class Affinity {
+        WORKER,
+        MAIN_THREAD,
+    };
+
+    Startup() = default;
+    ~Startup() = default;
+
+    Startup(const Startup& startup) = delete;
+    Startup& operator=(const Startup& startup) = delete;
+    Startup(Startup&& startup) = delete;
+    Startup& operator=(Startup&& startup) = delete;
+
+public:
+    void AddStage(const std::string& name, const std::vector<std::string>& dependencies, Affinity affinity, std::function<void()> task);
+    void Run();
+    void Report(const std::shared_ptr<spdlog::logger>& logger) const;
+    const std::vector<StageTiming>& Timings() const;
+    std::chrono::nanoseconds Elapsed() const;
+
+private:
+    struct Stage {
+        std::string name;
+        std::vector<size_t> dependencies;
+        Affinity affinity;
+        std::function<void()> task;
+    };
+
+private:
+    std::vector<Stage> stages_{};
+    std::vector<StageTiming> timings_{};
+    std::chrono::nanoseconds elapsed_{0};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_STARTUP_H_
\ No newline at end of file
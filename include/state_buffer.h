@@ -0,0 +1,80 @@
+/**
+ * @file state_buffer.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_STATE_BUFFER_H_)
+#define SERENITY_STATE_BUFFER_H_
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+
+namespace serenity {
+
+template <typename State>
+struct StatePair {
+    const State& previous;
+    const State& current;
+};
+
+/**
+ * Hands the last two simulated states from the simulation thread to the render thread without either waiting on
+ * the other's work. The writer fills a free slot and publishes it, which shifts current to previous; the reader
+ * acquires the latest pair and may read it until its next Acquire(). Only slot indices change hands under the
+ * mutex. Five slots cover the published pair, the pair the reader holds and the one being written. One writer and
+ * one reader.
+ */
+template <typename State>
+class StateBuffer {
+public:
+    StateBuffer() = default;
+    ~StateBuffer() = default;
+
+    StateBuffer(const StateBuffer& buffer) = delete;
+    StateBuffer& operator=(const StateBuffer& buffer) = delete;
+    StateBuffer(StateBuffer&& buffer) = delete;
+    StateBuffer& operator=(StateBuffer&& buffer) = delete;
+
+public:
+    // Writer: a slot holding some older state, to be overwritten in full. Reusing it keeps containers' capacity.
+    State& Begin() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (uint32_t slot = 0; slot < SLOTS; ++slot) {
+            if (slot != previous_ && slot != current_ && slot != held_previous_ && slot != held_current_) {
+                writing_ = slot;
+                break;
+            }
+        }
+        return slots_[writing_];
+    }
+    // Writer: the slot from Begin() becomes current.
+    void Publish() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        previous_ = current_;
+        current_ = writing_;
+    }
+    // Reader: the latest pair, stable until the next Acquire(). Both are default states until the first Publish().
+    StatePair<State> Acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        held_previous_ = previous_;
+        held_current_ = current_;
+        return {slots_[held_previous_], slots_[held_current_]};
+    }
+
+private:
+    static constexpr uint32_t SLOTS = 5;
+
+    std::array<State, SLOTS> slots_{};
+    std::mutex mutex_{};
+    uint32_t previous_{0};
+    uint32_t current_{0};
+    uint32_t held_previous_{0};
+    uint32_t held_current_{0};
+    uint32_t writing_{1};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_STATE_BUFFER_H_
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file statistics.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_STATISTICS_H_)
+#define SERENITY_STATISTICS_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace serenity {
+
+/**
+ * Fixed-capacity window over the most recent samples; once full, each new sample replaces the oldest one.
+ */
+class RollingSamples {
+public:
+    explicit RollingSamples(size_t capacity);
+    ~RollingSamples() = default;
+
+    RollingSamples() = delete;
+    RollingSamples(const RollingSamples& samples) = default;
+    RollingSamples& operator=(const RollingSamples& samples) = default;
+    RollingSamples(RollingSamples&& samples) = default;
+    RollingSamples& operator=(RollingSamples&& samples) = default;
+
+public:
+    void Add(double sample);
+    void Clear();
+    size_t Size() const;
+    bool Empty() const;
+    double Min() const;
+    double Max() const;
+    double Mean() const;
+    double Percentile(double percentile) const;
+    std::vector<double> Samples() const;
+
+private:
+    size_t capacity_{0};
+    size_t next_{0};
+    std::vector<double> samples_{};
+};
+
+double Percentile(std::vector<double> samples, double percentile);
+double Median(std::vector<double> samples);
+
+// One-sided Mann-Whitney U test: the probability of seeing candidate ranked at least this far above baseline if both
+// came from the same distribution. Uses the normal approximation with tie correction.
+double MannWhitneyGreater(const std::vector<double>& baseline, const std::vector<double>& candidate);
+
+}  // namespace serenity
+
+#endif  // SERENITY_STATISTICS_H_
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file thread_pool.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_THREAD_POOL_H_)
+#define SERENITY_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace serenity {
+
+/**
+ * Fixed set of worker threads for data-parallel work. ParallelFor() hands indices out one at a time through an atomic
+ * counter, and the calling thread takes part instead of blocking; while it waits for stragglers it runs other queued
+ * work, so a ParallelFor() nested inside another one cannot deadlock the pool. The first exception thrown by the task
+ * is rethrown on the caller once every started index has finished.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads = DefaultThreads());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool& pool) = delete;
+    ThreadPool& operator=(const ThreadPool& pool) = delete;
+    ThreadPool(ThreadPool&& pool) = delete;
+    ThreadPool& operator=(ThreadPool&& pool) = delete;
+
+public:
+    static size_t DefaultThreads();
+    size_t Size() const;
+    void ParallelFor(size_t count, const std::function<void(size_t index)>& task);
+
+private:
+    bool RunOne();
+    void Work();
+
+private:
+    std::mutex mutex_{};
+    std::condition_variable wake_{};
+    std::deque<std::function<void()>> tasks_{};
+    std::vector<std::thread> threads_{};
+    bool stopping_{false};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_THREAD_POOL_H_
\ No newline at end of file
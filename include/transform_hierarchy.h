@@ -0,0 +1,117 @@
+/**
+ * @file transform_hierarchy.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_TRANSFORM_HIERARCHY_H_)
+#define SERENITY_TRANSFORM_HIERARCHY_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/quaternion.hpp"
+#include "thread_pool.h"
+
+namespace serenity {
+
+using NodeId = uint32_t;
+constexpr NodeId INVALID_NODE = ~NodeId{0};
+
+struct Transform {
+    glm::vec3 position{0.0F};
+    glm::quat rotation{1.0F, 0.0F, 0.0F, 0.0F};
+    glm::vec3 scale{1.0F};
+};
+
+/**
+ * Scene graph of local transforms and their world matrices. Nodes are kept as parallel arrays in depth-first
+ * preorder, so every parent precedes its children and a subtree is one contiguous range. SetLocal() only records the
+ * node as dirty; Update() recomputes the dirty subtrees, each as a single forward sweep, and spreads independent
+ * subtrees over the thread pool. Nodes nobody touched are never visited. Static nodes cannot be moved and so never
+ * start a dirty subtree. NodeIds stay valid until their node is removed and are recycled afterwards.
+ */
+class TransformHierarchy {
+public:
+    // Subtrees above this many nodes are split into their children so one large dirty subtree still runs in parallel.
+    static constexpr size_t SPLIT_NODES = 4096;
+
+    TransformHierarchy() = default;
+    ~TransformHierarchy() = default;
+
+    TransformHierarchy(const TransformHierarchy& hierarchy) = delete;
+    TransformHierarchy& operator=(const TransformHierarchy& hierarchy) = delete;
+    TransformHierarchy(TransformHierarchy&& hierarchy) = delete;
+    TransformHierarchy& operator=(TransformHierarchy&& hierarchy) = delete;
+
+public:
+    // Pass INVALID_NODE as the parent to add a root.
+    NodeId Add(NodeId parent, const Transform& local, bool is_static = false);
+    // Removes the node together with its whole subtree.
+    void Remove(NodeId node);
+    void SetLocal(NodeId node, const Transform& local);
+    void SetStatic(NodeId node, bool is_static);
+    bool Alive(NodeId node) const;
+    bool IsStatic(NodeId node) const;
+    NodeId Parent(NodeId node) const;
+    const Transform& Local(NodeId node) const;
+    // Valid as of the last Update().
+    const glm::mat4& World(NodeId node) const;
+    // Brings worlds, indexed by NodeId and holding the matrices as of generation since, up to the last Update(). Only
+    // the ranges updated in between are copied while they are still known and no node was removed or reordered
+    // since; otherwise, and always from generation 0, every matrix is, with identity for unused ids.
+    void CopyWorlds(std::vector<glm::mat4>& worlds, uint64_t since) const;
+    size_t Size() const;
+    void Update(ThreadPool& pool);
+    // Counts Update() calls.
+    uint64_t Generation() const;
+    // Nodes whose world matrix the last Update() recomputed.
+    size_t Updated() const;
+
+private:
+    struct Range {
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    struct Sweeps {
+        uint64_t generation;
+        std::vector<Range> ranges;
+    };
+
+    // Updates whose swept ranges CopyWorlds() can replay.
+    static constexpr size_t HISTORY = 8;
+
+private:
+    uint32_t IndexOf(NodeId node) const;
+    void Reorder();
+    void Sweep(uint32_t begin, uint32_t end);
+
+private:
+    // Per node, in preorder.
+    std::vector<uint32_t> parents_{};
+    std::vector<uint32_t> subtree_sizes_{};
+    std::vector<Transform> locals_{};
+    std::vector<glm::mat4> worlds_{};
+    std::vector<uint8_t> static_{};
+    std::vector<uint8_t> dirty_{};
+    std::vector<NodeId> ids_{};
+    // Per NodeId.
+    std::vector<uint32_t> indices_{};
+    std::vector<NodeId> free_ids_{};
+    std::vector<NodeId> dirty_nodes_{};
+    // Set when an Add() could not keep preorder by appending; the next Update() re-sorts.
+    bool unordered_{false};
+    size_t updated_{0};
+    uint64_t generation_{0};
+    // Ranges swept before this generation index the arrays as they were laid out then.
+    uint64_t layout_generation_{0};
+    std::deque<Sweeps> history_{};
+};
+
+}  // namespace serenity
+
+#endif  // SERENITY_TRANSFORM_HIERARCHY_H_
\ No newline at end of file
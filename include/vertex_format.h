@@ -0,0 +1,136 @@
+/**
+ * @file vertex_format.h
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#if !defined(SERENITY_VERTEX_FORMAT_H_)
+#define SERENITY_VERTEX_FORMAT_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "glm.hpp"
+#include "gtc/type_precision.hpp"
+#include "mesh.h"
+#include "vulkan/vulkan.h"
+
+namespace serenity {
+
+enum class PositionFormat : uint8_t {
+    FLOAT32,
+    // Half floats relative to the mesh center.
+    HALF,
+    // 16-bit normalized relative to the mesh center, scaled by the half extent per axis.
+    SNORM16,
+};
+
+// Applies to normals and tangents alike.
+enum class NormalFormat : uint8_t {
+    FLOAT32,
+    // Two 16-bit normalized octahedral coordinates; tangents keep the bitangent sign in the low bit of y.
+    OCTAHEDRAL16,
+};
+
+enum class UvFormat : uint8_t {
+    FLOAT32,
+    HALF,
+    // 16-bit normalized over the mesh's UV range.
+    UNORM16,
+};
+
+/**
+ * Vertices are split into two streams: binding 0 holds positions only, so depth-only passes fetch just those, and
+ * binding 1 holds normal, tangent and UV interleaved. Locations are 0 position, 1 normal, 2 tangent, 3 UV.
+ */
+struct VertexFormat {
+    PositionFormat position{PositionFormat::FLOAT32};
+    NormalFormat normal{NormalFormat::FLOAT32};
+    UvFormat uv{UvFormat::FLOAT32};
+    bool tangents{false};
+    bool uvs{false};
+
+    uint32_t PositionStride() const;
+    uint32_t AttributeStride() const;
+    uint32_t NormalOffset() const;
+    uint32_t TangentOffset() const;
+    uint32_t UvOffset() const;
+};
+
+// Largest round-trip error the importer accepts for a compressed format; otherwise it keeps 32-bit floats.
+struct QuantizationBounds {
+    // Distance in mesh units.
+    float position_error{0.0005F};
+    // Angle in degrees, for normals and tangents.
+    float normal_error{0.25F};
+    // Per component; a quarter texel of a 1024 texture.
+    float uv_error{1.0F / 4096.0F};
+};
+
+// Uniforms the vertex shader applies to the stored values: position = position_offset + position_scale * stored.xyz
+// and uv = uv_offset + uv_scale * stored.
+struct Dequantization {
+    glm::vec3 position_offset{0.0F};
+    glm::vec3 position_scale{1.0F};
+    glm::vec2 uv_offset{0.0F};
+    glm::vec2 uv_scale{1.0F};
+};
+
+struct QuantizationReport {
+    uint64_t vertices{0};
+    // The same vertices as one interleaved stream of 32-bit floats.
+    uint64_t float_bytes{0};
+    uint64_t position_bytes{0};
+    uint64_t attribute_bytes{0};
+    // Largest round-trip errors, in the units of QuantizationBounds.
+    float position_error{0.0F};
+    float normal_error{0.0F};
+    float tangent_error{0.0F};
+    float uv_error{0.0F};
+
+    uint64_t Bytes() const {
+        return position_bytes + attribute_bytes;
+    }
+    // Fraction of vertex memory saved, which is also the bandwidth saved by passes that read every attribute.
+    double MemorySaving() const {
+        return float_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(Bytes()) / static_cast<double>(float_bytes);
+    }
+    // Fraction of vertex bandwidth saved by depth-only passes, which read the position stream alone instead of
+    // pulling whole interleaved vertices through the cache.
+    double DepthOnlySaving() const {
+        return float_bytes == 0 ? 0.0 : 1.0 - static_cast<double>(position_bytes) / static_cast<double>(float_bytes);
+    }
+};
+
+struct QuantizedMesh {
+    VertexFormat format{};
+    Dequantization dequantization{};
+    std::vector<uint8_t> positions{};
+    std::vector<uint8_t> attributes{};
+    std::vector<uint32_t> indices{};
+    QuantizationReport report{};
+};
+
+struct VertexInputLayout {
+    std::vector<VkVertexInputBindingDescription> bindings{};
+    std::vector<VkVertexInputAttributeDescription> attributes{};
+};
+
+// Picks, per attribute, the smallest format whose round-trip error on this mesh stays within bounds; between
+// formats of equal size, the one with the lower error.
+VertexFormat ChooseVertexFormat(const Mesh& mesh, const QuantizationBounds& bounds);
+// Throws if the mesh is invalid.
+QuantizedMesh Quantize(const Mesh& mesh, const VertexFormat& format);
+QuantizedMesh Quantize(const Mesh& mesh, const QuantizationBounds& bounds);
+// Decodes the streams the way the vertex shader does.
+Mesh Dequantize(const QuantizedMesh& mesh);
+// Depth-only passes bind the position stream alone.
+VertexInputLayout DescribeVertexInput(const VertexFormat& format, bool depth_only = false);
+
+// Picks the code whose decoded direction is closest to the input, not just the nearest rounding.
+glm::i16vec2 OctahedralEncode(const glm::vec3& direction);
+glm::vec3 OctahedralDecode(const glm::i16vec2& code);
+
+}  // namespace serenity
+
+#endif  // SERENITY_VERTEX_FORMAT_H_
\ No newline at end of file
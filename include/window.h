@@ -7,8 +7,10 @@
 #if !defined(SERENITY_WINDOW_H_)
 #define SERENITY_WINDOW_H_
 
+#include <chrono>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "glfw3.h"
@@ -18,6 +20,7 @@ namespace serenity {
 
 class Window {
 public:
+    // GLFW must already be initialized; Serenity does so in its "glfw" startup stage, which checks the result.
     Window(const std::string& title, int width, int height, const std::shared_ptr<spdlog::logger>& logger);
     ~Window();
 
@@ -28,12 +31,28 @@ public:
 
 public:
     bool ShouleClose() const;
+    bool IsMinimized() const;
+    bool IsVisible() const;
+    void PollEvents() const;
+    void WaitEvents(double timeout) const;
+    void Wake() const;
+    void SetTitle(const std::string& title);
+    void SetSize(int width, int height);
+    std::optional<std::chrono::steady_clock::time_point> ConsumeInputTime();
+
+private:
+    static void KeyCallback(GLFWwindow* window, int key, int scancode, int action, int mods);
+    static void MouseButtonCallback(GLFWwindow* window, int button, int action, int mods);
+    static void CursorPosCallback(GLFWwindow* window, double x, double y);
+    static void ScrollCallback(GLFWwindow* window, double x, double y);
+    void MarkInput();
 
 private:
     int width_{0};
     int height_{0};
     std::string title_{};
     GLFWwindow* window_{nullptr};
+    std::optional<std::chrono::steady_clock::time_point> input_time_{};
     std::shared_ptr<spdlog::logger> logger_;
 };
 
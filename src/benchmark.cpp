@@ -0,0 +1,160 @@
+/**
+ * @file benchmark.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+#include "process_stats.h"
+#include "scene_loader.h"
+#include "statistics.h"
+
+namespace serenity {
+
+namespace {
+
+nlohmann::json Summarize(const std::vector<double>& samples) {
+    nlohmann::json summary;
+    summary["count"] = samples.size();
+    summary["p50"] = Percentile(samples, 50.0);
+    summary["p90"] = Percentile(samples, 90.0);
+    summary["p95"] = Percentile(samples, 95.0);
+    summary["p99"] = Percentile(samples, 99.0);
+    summary["max"] = samples.empty() ? 0.0 : *std::max_element(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (auto sample : samples) {
+        sum += sample;
+    }
+    summary["mean"] = samples.empty() ? 0.0 : sum / static_cast<double>(samples.size());
+    summary["samples"] = samples;
+    return summary;
+}
+
+}  // namespace
+
+CameraPath::CameraPath(std::vector<CameraPose> keyframes) : keyframes_(std::move(keyframes)) {
+    if (keyframes_.empty()) {
+        throw std::runtime_error("A camera path needs at least one keyframe.");
+    }
+}
+
+CameraPath CameraPath::Orbit(const glm::vec3& center, float radius, float height, size_t keyframes) {
+    std::vector<CameraPose> poses;
+    poses.reserve(keyframes);
+    for (size_t i = 0; i < keyframes; ++i) {
+        const auto angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(keyframes);
+        CameraPose pose;
+        pose.position = center + glm::vec3(radius * std::cos(angle), height, radius * std::sin(angle));
+        pose.orientation = glm::quatLookAt(glm::normalize(center - pose.position), glm::vec3(0.0F, 1.0F, 0.0F));
+        poses.push_back(pose);
+    }
+    return CameraPath(std::move(poses));
+}
+
+CameraPose CameraPath::Sample(double t) const {
+    const auto position = (t - std::floor(t)) * static_cast<double>(keyframes_.size());
+    const auto index = std::min(static_cast<size_t>(position), keyframes_.size() - 1);
+    const auto& from = keyframes_[index];
+    const auto& to = keyframes_[(index + 1) % keyframes_.size()];
+    const auto blend = static_cast<float>(position - static_cast<double>(index));
+    return {glm::mix(from.position, to.position, blend), glm::slerp(from.orientation, to.orientation, blend)};
+}
+
+Benchmark::Benchmark(Serenity& app, BenchmarkOptions options) : app_(app), options_(std::move(options)) {
+}
+
+void Benchmark::SetFrameCallback(FrameCallback frame) {
+    frame_ = std::move(frame);
+}
+
+nlohmann::json Benchmark::Run() {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    nlohmann::json report;
+    report["name"] = options_.name;
+
+    glm::vec3 lower(std::numeric_limits<float>::max());
+    glm::vec3 upper(std::numeric_limits<float>::lowest());
+    SceneLoader loader(nullptr, [&lower, &upper](const EntityDesc& entity) {
+        lower = glm::min(lower, entity.position);
+        upper = glm::max(upper, entity.position);
+    });
+    const auto load_begin = std::chrono::steady_clock::now();
+    const auto scene = loader.Load(options_.scene);
+    report["scene"] = {
+        {"path", options_.scene.string()},
+        {"entities", scene.entities},
+        {"assets", scene.assets},
+        {"load_ms", Milliseconds(std::chrono::steady_clock::now() - load_begin).count()},
+    };
+    if (scene.entities == 0) {
+        lower = upper = glm::vec3(0.0F);
+    }
+    const auto center = (lower + upper) * 0.5F;
+    const auto radius = std::max(glm::length(upper - lower) * 0.75F, 1.0F);
+    const auto path = CameraPath::Orbit(center, radius, radius * 0.25F, 16);
+
+    // A pass only contributes to a frame's GPU time when the profiler read back a new sample for it.
+    std::map<std::string, size_t> gpu_samples;
+    auto gpu_frame_time = [this, &gpu_samples]() {
+        double total = 0.0;
+        bool fresh = false;
+        for (const auto& pass : app_.Profiler().Statistics()) {
+            auto& seen = gpu_samples[pass.name];
+            if (pass.samples != seen) {
+                total += pass.last_ms;
+                fresh = true;
+                seen = pass.samples;
+            }
+        }
+        return fresh ? total : -1.0;
+    };
+
+    const auto total = options_.warmup_frames + options_.frames;
+    uint32_t frame = 0;
+    app_.SetContinuousRendering(true);
+    app_.SetRenderCallback([this, &path, &frame, total](const SimulationState&, const SimulationState&, double) {
+        if (frame_) {
+            frame_(path.Sample(static_cast<double>(frame) / static_cast<double>(total)), frame);
+        }
+    });
+    std::vector<double> cpu_times;
+    std::vector<double> gpu_times;
+    cpu_times.reserve(options_.frames);
+    for (; frame < total; ++frame) {
+        const auto begin = std::chrono::steady_clock::now();
+        app_.Frame();
+        const auto cpu_time = Milliseconds(std::chrono::steady_clock::now() - begin).count();
+        const auto gpu_time = gpu_frame_time();
+        if (frame < options_.warmup_frames) {
+            continue;
+        }
+        cpu_times.push_back(cpu_time);
+        if (gpu_time >= 0.0) {
+            gpu_times.push_back(gpu_time);
+        }
+    }
+    app_.SetRenderCallback(nullptr);
+
+    std::chrono::nanoseconds startup{0};
+    for (const auto& timing : app_.StartupTimings()) {
+        startup = std::max(startup, timing.start + timing.duration);
+    }
+    report["frames"] = options_.frames;
+    report["warmup_frames"] = options_.warmup_frames;
+    report["startup_ms"] = Milliseconds(startup).count();
+    report["cpu_frame_ms"] = Summarize(cpu_times);
+    report["gpu_frame_ms"] = Summarize(gpu_times);
+    report["peak_rss_bytes"] = PeakResidentBytes();
+    report["pipeline_compiles"] = app_.GetDevice().PipelineCompiles();
+    return report;
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * @file bounds.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "bounds.h"
+
+#include <algorithm>
+
+namespace serenity {
+
+float Intersect(const Ray& ray, const Aabb& box) {
+    const auto inverse = 1.0F / ray.direction;
+    const auto t1 = (box.min - ray.origin) * inverse;
+    const auto t2 = (box.max - ray.origin) * inverse;
+    const auto lower = glm::min(t1, t2);
+    const auto upper = glm::max(t1, t2);
+    const auto enter = std::max({lower.x, lower.y, lower.z, 0.0F});
+    const auto exit = std::min({upper.x, upper.y, upper.z, ray.max_distance});
+    return enter <= exit ? enter : -1.0F;
+}
+
+Frustum Frustum::FromViewProjection(const glm::mat4& view_projection) {
+    // glm is column-major, so row i of the matrix is (m[0][i], m[1][i], m[2][i], m[3][i]).
+    const auto row = [&view_projection](int i) {
+        return glm::vec4(view_projection[0][i], view_projection[1][i], view_projection[2][i], view_projection[3][i]);
+    };
+    Frustum frustum;
+    frustum.planes = {row(3) + row(0), row(3) - row(0), row(3) + row(1), row(3) - row(1), row(2), row(3) - row(2)};
+    for (auto& plane : frustum.planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+    return frustum;
+}
+
+Aabb Frustum::Bounds() const {
+    // Each corner is where one of left/right, one of bottom/top and one of near/far meet.
+    const auto corner = [this](size_t a, size_t b, size_t c) {
+        const glm::vec3 na(planes[a]);
+        const glm::vec3 nb(planes[b]);
+        const glm::vec3 nc(planes[c]);
+        const auto bc = glm::cross(nb, nc);
+        return -(planes[a].w * bc + planes[b].w * glm::cross(nc, na) + planes[c].w * glm::cross(na, nb)) / glm::dot(na, bc);
+    };
+    Aabb box;
+    for (size_t x = 0; x < 2; ++x) {
+        for (size_t y = 2; y < 4; ++y) {
+            for (size_t z = 4; z < 6; ++z) {
+                box.Grow(corner(x, y, z));
+            }
+        }
+    }
+    return box;
+}
+
+Containment Frustum::Classify(const Aabb& box) const {
+    const auto center = box.Center();
+    const auto half = box.max - center;
+    auto result = Containment::INSIDE;
+    for (const auto& plane : planes) {
+        const glm::vec3 normal(plane);
+        const auto distance = glm::dot(normal, center) + plane.w;
+        const auto radius = glm::dot(half, glm::abs(normal));
+        if (distance < -radius) {
+            return Containment::OUTSIDE;
+        }
+        if (distance < radius) {
+            result = Containment::INTERSECTS;
+        }
+    }
+    return result;
+}
+
+bool Frustum::Intersects(const glm::vec3& center, float radius) const {
+    return std::all_of(planes.begin(), planes.end(), [&center, radius](const glm::vec4& plane) {
+        return glm::dot(glm::vec3(plane), center) + plane.w >= -radius;
+    });
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,462 @@
+/**
+ * @file bvh.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "bvh.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+namespace {
+
+template <typename Node>
+Aabb BoundsOf(const Node& node) {
+    return {node.min, node.max};
+}
+
+uint32_t Bin(float center, float origin, float scale) {
+    return std::min(Bvh::BINS - 1, static_cast<uint32_t>((center - origin) * scale));
+}
+
+/**
+ * Slab test against a box. The origin and inverse direction are prepared once per ray; for nodes the lane after z
+ * holds the node's integer field and is never read back.
+ */
+struct RaySlabs {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    explicit RaySlabs(const Ray& ray) : origin(_mm_set_ps(0.0F, ray.origin.z, ray.origin.y, ray.origin.x)), inverse(_mm_set_ps(0.0F, 1.0F / ray.direction.z, 1.0F / ray.direction.y, 1.0F / ray.direction.x)) {}
+
+    // Distance at which the ray enters the box, or a negative value if it misses before limit.
+    template <typename Node>
+    float Enter(const Node& node, float limit) const {
+        return Enter(_mm_loadu_ps(&node.min.x), _mm_loadu_ps(&node.max.x), limit);
+    }
+
+    // An Aabb has nothing after its max, so that one is loaded lane by lane.
+    float Enter(const Aabb& box, float limit) const {
+        return Enter(_mm_loadu_ps(&box.min.x), _mm_set_ps(0.0F, box.max.z, box.max.y, box.max.x), limit);
+    }
+
+    float Enter(__m128 min, __m128 max, float limit) const {
+        const auto t1 = _mm_mul_ps(_mm_sub_ps(min, origin), inverse);
+        const auto t2 = _mm_mul_ps(_mm_sub_ps(max, origin), inverse);
+        const auto lower = _mm_min_ps(t1, t2);
+        const auto upper = _mm_max_ps(t1, t2);
+        const auto enter = _mm_max_ss(_mm_max_ss(lower, _mm_shuffle_ps(lower, lower, _MM_SHUFFLE(1, 1, 1, 1))), _mm_max_ss(_mm_shuffle_ps(lower, lower, _MM_SHUFFLE(2, 2, 2, 2)), _mm_setzero_ps()));
+        const auto exit = _mm_min_ss(_mm_min_ss(upper, _mm_shuffle_ps(upper, upper, _MM_SHUFFLE(1, 1, 1, 1))), _mm_min_ss(_mm_shuffle_ps(upper, upper, _MM_SHUFFLE(2, 2, 2, 2)), _mm_set_ss(limit)));
+        const auto distance = _mm_cvtss_f32(enter);
+        return distance <= _mm_cvtss_f32(exit) ? distance : -1.0F;
+    }
+
+    __m128 origin;
+    __m128 inverse;
+#else
+    explicit RaySlabs(const Ray& ray) : origin(ray.origin), inverse(1.0F / ray.direction) {}
+
+    template <typename Box>
+    float Enter(const Box& box, float limit) const {
+        const auto t1 = (box.min - origin) * inverse;
+        const auto t2 = (box.max - origin) * inverse;
+        const auto lower = glm::min(t1, t2);
+        const auto upper = glm::max(t1, t2);
+        const auto enter = std::max({lower.x, lower.y, lower.z, 0.0F});
+        const auto exit = std::min({upper.x, upper.y, upper.z, limit});
+        return enter <= exit ? enter : -1.0F;
+    }
+
+    glm::vec3 origin;
+    glm::vec3 inverse;
+#endif
+};
+
+}  // namespace
+
+void Bvh::Build(std::vector<Aabb> bounds) {
+    SERENITY_ZONE_FUNCTION();
+    // A rebuild in flight was started from the old primitives and is of no use any more.
+    if (rebuild_.valid()) {
+        rebuild_.wait();
+        rebuild_ = {};
+    }
+    bounds_ = std::move(bounds);
+    Adopt(BuildTree(bounds_));
+    cost_ = built_cost_;
+    updated_ = false;
+}
+
+size_t Bvh::Size() const {
+    return bounds_.size();
+}
+
+size_t Bvh::NodeCount() const {
+    return nodes_.size();
+}
+
+const Aabb& Bvh::Bounds(uint32_t primitive) const {
+    return bounds_[primitive];
+}
+
+void Bvh::Update(uint32_t primitive, const Aabb& bounds) {
+    if (primitive >= bounds_.size()) {
+        throw std::runtime_error("Unknown BVH primitive " + std::to_string(primitive) + ".");
+    }
+    bounds_[primitive] = bounds;
+    updated_ = true;
+}
+
+void Bvh::Refit() {
+    SERENITY_ZONE_FUNCTION();
+    if (rebuild_.valid() && rebuild_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        Adopt(rebuild_.get());
+    }
+    // Children always come after their parent, so a reverse sweep sees both children before the parent.
+    for (auto i = nodes_.size(); i-- > 0;) {
+        if (i == PADDING_NODE) {
+            continue;
+        }
+        auto& node = nodes_[i];
+        Aabb box;
+        if (node.count > 0) {
+            for (auto j = node.offset; j < node.offset + node.count; ++j) {
+                box.Grow(bounds_[primitives_[j]]);
+            }
+        } else {
+            box.Grow(BoundsOf(nodes_[node.offset]));
+            box.Grow(BoundsOf(nodes_[node.offset + 1]));
+        }
+        node.min = box.min;
+        node.max = box.max;
+    }
+    cost_ = SahCost(nodes_);
+    updated_ = false;
+    if (Degradation() > REBUILD_DEGRADATION) {
+        RebuildAsync();
+    }
+}
+
+bool Bvh::NeedsRefit() const {
+    return updated_ || Rebuilding();
+}
+
+float Bvh::Cost() const {
+    return cost_;
+}
+
+float Bvh::Degradation() const {
+    return built_cost_ > 0.0F ? cost_ / built_cost_ : 1.0F;
+}
+
+void Bvh::RebuildAsync() {
+    if (Rebuilding()) {
+        return;
+    }
+    rebuild_ = std::async(std::launch::async, [bounds = bounds_]() {
+        return BuildTree(bounds);
+    });
+}
+
+bool Bvh::Rebuilding() const {
+    return rebuild_.valid();
+}
+
+RayHit Bvh::Raycast(const Ray& ray, const Intersector& intersect) const {
+    struct Entry {
+        uint32_t node;
+        float distance;
+    };
+
+    RayHit hit;
+    if (nodes_.empty()) {
+        return hit;
+    }
+    const RaySlabs slabs(ray);
+    auto closest = ray.max_distance;
+    const auto root = slabs.Enter(nodes_[0], closest);
+    if (root < 0.0F) {
+        return hit;
+    }
+    std::vector<Entry> stack;
+    stack.reserve(64);
+    stack.push_back({0, root});
+    Ray clipped = ray;
+    while (!stack.empty()) {
+        const auto entry = stack.back();
+        stack.pop_back();
+        // A closer hit may have been found since this node was pushed.
+        if (entry.distance > closest) {
+            continue;
+        }
+        const auto& node = nodes_[entry.node];
+        if (node.count > 0) {
+            for (auto i = node.offset; i < node.offset + node.count; ++i) {
+                const auto primitive = primitives_[i];
+                clipped.max_distance = closest;
+                const auto distance = intersect ? intersect(primitive, clipped) : slabs.Enter(bounds_[primitive], closest);
+                if (distance >= 0.0F && distance <= closest) {
+                    closest = distance;
+                    hit = {primitive, distance};
+                }
+            }
+            continue;
+        }
+        const auto left = slabs.Enter(nodes_[node.offset], closest);
+        const auto right = slabs.Enter(nodes_[node.offset + 1], closest);
+        // Push the far child first so the near one is visited next and can shorten the ray for the other.
+        if (left >= 0.0F && right >= 0.0F) {
+            if (left <= right) {
+                stack.push_back({node.offset + 1, right});
+                stack.push_back({node.offset, left});
+            } else {
+                stack.push_back({node.offset, left});
+                stack.push_back({node.offset + 1, right});
+            }
+        } else if (left >= 0.0F) {
+            stack.push_back({node.offset, left});
+        } else if (right >= 0.0F) {
+            stack.push_back({node.offset + 1, right});
+        }
+    }
+    return hit;
+}
+
+void Bvh::Overlap(const Aabb& box, std::vector<uint32_t>& primitives) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+        if (!box.Overlaps(BoundsOf(node))) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back(node.offset + 1);
+            stack.push_back(node.offset);
+            continue;
+        }
+        for (auto i = node.offset; i < node.offset + node.count; ++i) {
+            if (box.Overlaps(bounds_[primitives_[i]])) {
+                primitives.push_back(primitives_[i]);
+            }
+        }
+    }
+}
+
+void Bvh::Nearby(const glm::vec3& center, float radius, std::vector<uint32_t>& primitives) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    const auto squared = radius * radius;
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const auto& node = nodes_[stack.back()];
+        stack.pop_back();
+        if (BoundsOf(node).SquaredDistance(center) > squared) {
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back(node.offset + 1);
+            stack.push_back(node.offset);
+            continue;
+        }
+        for (auto i = node.offset; i < node.offset + node.count; ++i) {
+            if (bounds_[primitives_[i]].SquaredDistance(center) <= squared) {
+                primitives.push_back(primitives_[i]);
+            }
+        }
+    }
+}
+
+void Bvh::Cull(const Frustum& frustum, std::vector<uint32_t>& primitives) const {
+    if (nodes_.empty()) {
+        return;
+    }
+    std::vector<uint32_t> stack{0};
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        const auto& node = nodes_[index];
+        const auto containment = frustum.Classify(BoundsOf(node));
+        if (containment == Containment::OUTSIDE) {
+            continue;
+        }
+        // Everything below a node that is fully inside is visible, no more plane tests needed.
+        if (containment == Containment::INSIDE) {
+            CollectSubtree(index, primitives);
+            continue;
+        }
+        if (node.count == 0) {
+            stack.push_back(node.offset + 1);
+            stack.push_back(node.offset);
+            continue;
+        }
+        for (auto i = node.offset; i < node.offset + node.count; ++i) {
+            if (frustum.Classify(bounds_[primitives_[i]]) != Containment::OUTSIDE) {
+                primitives.push_back(primitives_[i]);
+            }
+        }
+    }
+}
+
+Bvh::Tree Bvh::BuildTree(const std::vector<Aabb>& bounds) {
+    SERENITY_ZONE_FUNCTION();
+    struct Task {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+    };
+
+    struct BinData {
+        Aabb bounds;
+        uint32_t count{0};
+    };
+
+    Tree tree;
+    const auto count = static_cast<uint32_t>(bounds.size());
+    tree.primitives.resize(count);
+    std::iota(tree.primitives.begin(), tree.primitives.end(), 0);
+    if (count == 0) {
+        tree.cost = 0.0F;
+        return tree;
+    }
+    std::vector<glm::vec3> centers(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        centers[i] = bounds[i].Center();
+    }
+    // A binary tree with non-empty leaves has at most 2n - 1 nodes, plus the padding slot.
+    tree.nodes.reserve(2 * static_cast<size_t>(count));
+    tree.nodes.push_back({});
+    std::vector<Task> stack{{0, 0, count}};
+    while (!stack.empty()) {
+        const auto task = stack.back();
+        stack.pop_back();
+        Aabb box;
+        Aabb centroids;
+        for (auto i = task.begin; i < task.end; ++i) {
+            box.Grow(bounds[tree.primitives[i]]);
+            centroids.Grow(centers[tree.primitives[i]]);
+        }
+        auto& node = tree.nodes[task.node];
+        node.min = box.min;
+        node.max = box.max;
+        node.count = task.end - task.begin;
+        node.offset = task.begin;
+        if (node.count <= MAX_LEAF_PRIMITIVES) {
+            continue;
+        }
+
+        // Bin centroids along each axis and pick the boundary with the lowest area-weighted primitive count.
+        int best_axis = -1;
+        uint32_t best_split = 0;
+        auto best_cost = std::numeric_limits<float>::max();
+        const auto extent = centroids.max - centroids.min;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (extent[axis] <= 0.0F) {
+                continue;
+            }
+            const auto scale = static_cast<float>(BINS) / extent[axis];
+            std::array<BinData, BINS> bins{};
+            for (auto i = task.begin; i < task.end; ++i) {
+                auto& bin = bins[Bin(centers[tree.primitives[i]][axis], centroids.min[axis], scale)];
+                bin.bounds.Grow(bounds[tree.primitives[i]]);
+                ++bin.count;
+            }
+            std::array<float, BINS> left_areas{};
+            std::array<uint32_t, BINS> left_counts{};
+            BinData left;
+            for (uint32_t split = 1; split < BINS; ++split) {
+                left.bounds.Grow(bins[split - 1].bounds);
+                left.count += bins[split - 1].count;
+                left_areas[split] = left.bounds.SurfaceArea();
+                left_counts[split] = left.count;
+            }
+            BinData right;
+            for (auto split = BINS - 1; split > 0; --split) {
+                right.bounds.Grow(bins[split].bounds);
+                right.count += bins[split].count;
+                if (left_counts[split] == 0 || right.count == 0) {
+                    continue;
+                }
+                const auto cost = left_areas[split] * static_cast<float>(left_counts[split]) + right.bounds.SurfaceArea() * static_cast<float>(right.count);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                    best_split = split;
+                }
+            }
+        }
+
+        auto middle = task.begin + (task.end - task.begin) / 2;
+        if (best_axis >= 0) {
+            const auto scale = static_cast<float>(BINS) / extent[best_axis];
+            const auto origin = centroids.min[best_axis];
+            const auto split = std::partition(tree.primitives.begin() + task.begin, tree.primitives.begin() + task.end, [&](uint32_t primitive) {
+                return Bin(centers[primitive][best_axis], origin, scale) < best_split;
+            });
+            middle = static_cast<uint32_t>(split - tree.primitives.begin());
+        }
+        // Otherwise every centroid coincides and any split is as good as another.
+        if (tree.nodes.size() == PADDING_NODE) {
+            tree.nodes.push_back({});
+        }
+        const auto left = static_cast<uint32_t>(tree.nodes.size());
+        tree.nodes[task.node].count = 0;
+        tree.nodes[task.node].offset = left;
+        tree.nodes.push_back({});
+        tree.nodes.push_back({});
+        stack.push_back({left + 1, middle, task.end});
+        stack.push_back({left, task.begin, middle});
+    }
+    tree.cost = SahCost(tree.nodes);
+    return tree;
+}
+
+float Bvh::SahCost(const Nodes& nodes) {
+    if (nodes.empty()) {
+        return 0.0F;
+    }
+    const auto root = BoundsOf(nodes[0]).SurfaceArea();
+    if (root <= 0.0F) {
+        return 0.0F;
+    }
+    // Unit cost per node visited and per primitive tested, weighted by the chance a random ray hits the box.
+    double cost = 0.0;
+    for (const auto& node : nodes) {
+        cost += static_cast<double>(BoundsOf(node).SurfaceArea()) * (node.count > 0 ? node.count : 1);
+    }
+    return static_cast<float>(cost / root);
+}
+
+void Bvh::Adopt(Tree tree) {
+    nodes_ = std::move(tree.nodes);
+    primitives_ = std::move(tree.primitives);
+    built_cost_ = tree.cost;
+}
+
+void Bvh::CollectSubtree(uint32_t node, std::vector<uint32_t>& primitives) const {
+    // The builder partitions primitives in place, so a subtree's primitives are one range: from its leftmost leaf to
+    // the end of its rightmost leaf.
+    auto first = node;
+    while (nodes_[first].count == 0) {
+        first = nodes_[first].offset;
+    }
+    auto last = node;
+    while (nodes_[last].count == 0) {
+        last = nodes_[last].offset + 1;
+    }
+    primitives.insert(primitives.end(), primitives_.begin() + nodes_[first].offset, primitives_.begin() + nodes_[last].offset + nodes_[last].count);
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,198 @@
+/**
+ * @file config.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "config.h"
+
+#include <array>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif  // __linux__
+
+namespace serenity {
+
+Config::Config(const std::filesystem::path& path) : path_(path) {
+    cache_path_ = path_;
+    cache_path_ += ".msgpack";
+    settings_ = Load();
+    previous_ = settings_;
+    std::error_code error;
+    write_time_ = std::filesystem::last_write_time(path_, error);
+#if defined(__linux__)
+    inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (inotify_fd_ >= 0) {
+        const auto directory = path_.has_parent_path() ? path_.parent_path() : std::filesystem::path(".");
+        watch_fd_ = inotify_add_watch(inotify_fd_, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+    }
+#endif  // __linux__
+}
+
+Config::~Config() {
+#if defined(__linux__)
+    if (inotify_fd_ >= 0) {
+        close(inotify_fd_);
+    }
+#endif  // __linux__
+}
+
+const Settings& Config::Get() const {
+    return settings_;
+}
+
+const Settings& Config::Previous() const {
+    return previous_;
+}
+
+void Config::SetLogger(const std::shared_ptr<spdlog::logger>& logger) {
+    logger_ = logger;
+    ReportUnknownKeys();
+}
+
+bool Config::Poll() {
+    if (!Changed()) {
+        return false;
+    }
+    Settings settings;
+    try {
+        settings = Load();
+    } catch (const std::exception& e) {
+        // Most likely caught mid-write; the write that completes it raises another event.
+        if (logger_) {
+            logger_->warn("Ignoring config reload of {}: {}", path_.string(), e.what());
+        }
+        return false;
+    }
+    if (settings == settings_) {
+        return false;
+    }
+    previous_ = std::move(settings_);
+    settings_ = std::move(settings);
+    if (logger_) {
+        ReportUnknownKeys();
+        logger_->info("Config {} reloaded", path_.string());
+    }
+    return true;
+}
+
+bool Config::Changed() {
+    bool changed = false;
+#if defined(__linux__)
+    if (watch_fd_ >= 0) {
+        alignas(inotify_event) std::array<char, 4096> buffer{};
+        const auto filename = path_.filename().string();
+        ssize_t length = 0;
+        while ((length = read(inotify_fd_, buffer.data(), buffer.size())) > 0) {
+            for (ssize_t offset = 0; offset < length;) {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                if (event->len > 0 && filename == event->name) {
+                    changed = true;
+                }
+                offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            }
+        }
+        return changed;
+    }
+#endif  // __linux__
+    std::error_code error;
+    const auto write_time = std::filesystem::last_write_time(path_, error);
+    if (!error && write_time != write_time_) {
+        write_time_ = write_time;
+        changed = true;
+    }
+    return changed;
+}
+
+Settings Config::Load() {
+    std::error_code write_error;
+    std::error_code size_error;
+    const auto write_time = std::filesystem::last_write_time(path_, write_error);
+    const auto size = std::filesystem::file_size(path_, size_error);
+    const auto stamp = write_time.time_since_epoch().count();
+    nlohmann::json json;
+    if (!write_error && !size_error && size >= CACHE_THRESHOLD_ && std::filesystem::exists(cache_path_)) {
+        try {
+            std::ifstream cache(cache_path_, std::ios::binary);
+            auto cached = nlohmann::json::from_msgpack(cache);
+            // A newer cache is not enough: a copied or restored source can be older than it and still differ.
+            if (cached.value("source_size", std::uintmax_t{0}) == size && cached.value("source_time", decltype(stamp){0}) == stamp && cached.contains("settings")) {
+                json = std::move(cached["settings"]);
+            }
+        } catch (const nlohmann::json::exception&) {
+            json = nullptr;
+        }
+    }
+    if (json.is_null()) {
+        std::ifstream file(path_);
+        if (!file) {
+            throw std::runtime_error("Failed to open config " + path_.string() + ".");
+        }
+        json = nlohmann::json::parse(file);
+        if (!write_error && !size_error && size >= CACHE_THRESHOLD_) {
+            std::ofstream cache(cache_path_, std::ios::binary | std::ios::trunc);
+            nlohmann::json::to_msgpack({{"source_size", size}, {"source_time", stamp}, {"settings", json}}, cache);
+        }
+    }
+    if (!json.is_object()) {
+        throw std::runtime_error("Config " + path_.string() + " must be a JSON object.");
+    }
+    const nlohmann::json known = Settings{};
+    unknown_keys_.clear();
+    for (const auto& item : json.items()) {
+        if (!known.contains(item.key())) {
+            unknown_keys_.push_back(item.key());
+            continue;
+        }
+        // The conversion to uint32_t would silently wrap -1 to 4294967295, which then passes every "> 0" check.
+        const auto& value = item.value();
+        if (known[item.key()].is_number_unsigned() && (!value.is_number_unsigned() || value.get<uint64_t>() > std::numeric_limits<uint32_t>::max())) {
+            throw std::runtime_error("Config " + path_.string() + ": " + item.key() + " must be a non-negative 32-bit integer.");
+        }
+    }
+    auto settings = json.get<Settings>();
+    Validate(settings);
+    return settings;
+}
+
+void Config::ReportUnknownKeys() {
+    for (const auto& key : unknown_keys_) {
+        logger_->warn("Unknown key {} in config {}", key, path_.string());
+    }
+    unknown_keys_.clear();
+}
+
+void Config::Validate(const Settings& settings) const {
+    auto check = [this](bool valid, const char* message) {
+        if (!valid) {
+            throw std::runtime_error("Config " + path_.string() + ": " + message);
+        }
+    };
+    check(settings.log_level == "off" || spdlog::level::from_str(settings.log_level) != spdlog::level::off, "log_level is not a spdlog level.");
+    check(settings.window_width > 0 && settings.window_height > 0, "window_width and window_height must be positive.");
+    for (auto channel : {settings.clear_color_red, settings.clear_color_green, settings.clear_color_blue, settings.clear_color_alpha}) {
+        check(channel >= 0.0F && channel <= 1.0F, "clear color channels must be within [0, 1].");
+    }
+    check(settings.simulation_rate > 0.0, "simulation_rate must be positive.");
+    check(settings.max_simulation_steps > 0, "max_simulation_steps must be positive.");
+    check(settings.idle_wait_timeout >= 0.0, "idle_wait_timeout must not be negative.");
+    check(settings.target_frame_time >= 0.0, "target_frame_time must not be negative.");
+    check(settings.max_queued_frames > 0, "max_queued_frames must be positive.");
+    check(settings.frames_in_flight > 0, "frames_in_flight must be positive.");
+    check(settings.flight_recorder_window > 0.0, "flight_recorder_window must be positive.");
+    check(settings.hitch_budget >= 0.0, "hitch_budget must not be negative.");
+    check(settings.memory_budget_fraction > 0.0 && settings.memory_budget_fraction <= 1.0, "memory_budget_fraction must be in (0, 1].");
+    check(settings.metrics_port <= 65535, "metrics_port must be a TCP port.");
+    check(settings.instancing_threshold > 0, "instancing_threshold must be positive.");
+    check(settings.lod_pixel_error > 0.0F, "lod_pixel_error must be positive.");
+    check(settings.lod_hysteresis >= 0.0F && settings.lod_hysteresis < 1.0F, "lod_hysteresis must be in [0, 1).");
+    check(settings.lod_fade_time >= 0.0, "lod_fade_time must not be negative.");
+    check(settings.gpu_profiler_max_passes > 0, "gpu_profiler_max_passes must be positive.");
+}
+
+}  // namespace serenity
\ No newline at end of file
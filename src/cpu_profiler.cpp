@@ -0,0 +1,307 @@
+/**
+ * @file cpu_profiler.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "cpu_profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "json.hpp"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define SERENITY_HAS_TSC_
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define SERENITY_HAS_TSC_
+#endif
+
+namespace serenity {
+
+namespace {
+
+constexpr uint32_t PROCESS_ID = 1;
+constexpr uint64_t GPU_TRACK_UUID = 0xFFFF;
+
+// Just enough protobuf encoding for the Perfetto TracePacket / TrackEvent schema.
+class ProtoWriter {
+public:
+    void Varint(uint64_t value) {
+        while (value >= 0x80) {
+            data_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        data_.push_back(static_cast<char>(value));
+    }
+
+    void UInt(uint32_t field, uint64_t value) {
+        Varint(static_cast<uint64_t>(field) << 3);
+        Varint(value);
+    }
+
+    void Bytes(uint32_t field, std::string_view bytes) {
+        Varint((static_cast<uint64_t>(field) << 3) | 2);
+        Varint(bytes.size());
+        data_.append(bytes);
+    }
+
+    void Message(uint32_t field, const ProtoWriter& message) {
+        Bytes(field, message.data_);
+    }
+
+    const std::string& Data() const {
+        return data_;
+    }
+
+private:
+    std::string data_{};
+};
+
+// Field numbers from perfetto/protos/perfetto/trace/trace_packet.proto and track_event/*.proto.
+namespace perfetto {
+constexpr uint32_t TRACE_PACKET = 1;
+constexpr uint32_t PACKET_TIMESTAMP = 8;
+constexpr uint32_t PACKET_SEQUENCE_ID = 10;
+constexpr uint32_t PACKET_TRACK_EVENT = 11;
+constexpr uint32_t PACKET_SEQUENCE_FLAGS = 13;
+constexpr uint32_t PACKET_TRACK_DESCRIPTOR = 60;
+constexpr uint32_t DESCRIPTOR_UUID = 1;
+constexpr uint32_t DESCRIPTOR_NAME = 2;
+constexpr uint32_t DESCRIPTOR_THREAD = 4;
+constexpr uint32_t THREAD_PID = 1;
+constexpr uint32_t THREAD_TID = 2;
+constexpr uint32_t THREAD_NAME = 5;
+constexpr uint32_t EVENT_TYPE = 9;
+constexpr uint32_t EVENT_TRACK_UUID = 11;
+constexpr uint32_t EVENT_NAME = 23;
+constexpr uint64_t TYPE_SLICE_BEGIN = 1;
+constexpr uint64_t TYPE_SLICE_END = 2;
+constexpr uint64_t SEQ_INCREMENTAL_STATE_CLEARED = 1;
+constexpr uint64_t SEQUENCE_ID = 1;
+}  // namespace perfetto
+
+}  // namespace
+
+CpuProfiler& CpuProfiler::Get() {
+    static CpuProfiler profiler;
+    return profiler;
+}
+
+CpuProfiler::CpuProfiler() : origin_ticks_(Now()), origin_time_(std::chrono::steady_clock::now()) {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->id = static_cast<uint32_t>(GPU_TRACK_UUID);
+    buffer->name = "GPU";
+    gpu_buffer_ = buffer.get();
+    buffers_.push_back(std::move(buffer));
+}
+
+uint64_t CpuProfiler::Now() {
+#if defined(SERENITY_HAS_TSC_)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif  // SERENITY_HAS_TSC_
+}
+
+void CpuProfiler::Record(const char* name, uint64_t begin, uint64_t end) {
+    Push(LocalBuffer(), {name, begin, end});
+}
+
+void CpuProfiler::RecordGpu(const std::string& name, uint64_t begin, uint64_t end) {
+    const char* interned = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        interned = gpu_names_.insert(name).first->c_str();
+    }
+    Push(*gpu_buffer_, {interned, begin, end});
+}
+
+void CpuProfiler::SetThreadName(const std::string& name) {
+    auto& buffer = LocalBuffer();
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer.name = name;
+}
+
+double CpuProfiler::NanosecondsPerTick() {
+#if defined(SERENITY_HAS_TSC_)
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (nanoseconds_per_tick_ > 0.0) {
+        return nanoseconds_per_tick_;
+    }
+    // Calibrate the TSC against the steady clock over at least 10 ms; keep the ratio once the baseline is long.
+    constexpr auto MIN_CALIBRATION = std::chrono::milliseconds(10);
+    constexpr auto STABLE_CALIBRATION = std::chrono::milliseconds(100);
+    auto elapsed = std::chrono::steady_clock::now() - origin_time_;
+    if (elapsed < MIN_CALIBRATION) {
+        std::this_thread::sleep_for(MIN_CALIBRATION - elapsed);
+    }
+    const auto ticks = Now() - origin_ticks_;
+    elapsed = std::chrono::steady_clock::now() - origin_time_;
+    const auto ratio = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) / static_cast<double>(ticks);
+    if (elapsed >= STABLE_CALIBRATION) {
+        nanoseconds_per_tick_ = ratio;
+    }
+    return ratio;
+#else
+    return 1.0;
+#endif  // SERENITY_HAS_TSC_
+}
+
+std::vector<ThreadCapture> CpuProfiler::Capture() {
+    const auto scale = NanosecondsPerTick();
+    std::vector<ThreadCapture> captures;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& buffer : buffers_) {
+        ThreadCapture capture{buffer->id, buffer->name, Snapshot(*buffer)};
+        for (auto& event : capture.events) {
+            // Events recorded before the origin cannot exist, but clamp rather than wrap if the TSC misbehaves.
+            event.begin = static_cast<uint64_t>(static_cast<double>(event.begin > origin_ticks_ ? event.begin - origin_ticks_ : 0) * scale);
+            event.end = static_cast<uint64_t>(static_cast<double>(event.end > origin_ticks_ ? event.end - origin_ticks_ : 0) * scale);
+        }
+        if (!capture.events.empty()) {
+            captures.push_back(std::move(capture));
+        }
+    }
+    return captures;
+}
+
+void CpuProfiler::ExportChromeTrace(const std::filesystem::path& path) {
+    auto events = nlohmann::json::array();
+    for (const auto& thread : Capture()) {
+        events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", PROCESS_ID}, {"tid", thread.id}, {"args", {{"name", thread.name}}}});
+        for (const auto& event : thread.events) {
+            events.push_back({
+                {"name", event.name},
+                {"ph", "X"},
+                {"ts", static_cast<double>(event.begin) / 1e3},
+                {"dur", static_cast<double>(event.end - event.begin) / 1e3},
+                {"pid", PROCESS_ID},
+                {"tid", thread.id},
+            });
+        }
+    }
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open trace " + path.string() + ".");
+    }
+    file << nlohmann::json{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}}.dump();
+}
+
+void CpuProfiler::ExportPerfetto(const std::filesystem::path& path) {
+    using namespace perfetto;
+    ProtoWriter trace;
+    bool first_packet = true;
+    auto emit = [&trace, &first_packet](ProtoWriter& packet) {
+        packet.UInt(PACKET_SEQUENCE_ID, SEQUENCE_ID);
+        if (first_packet) {
+            packet.UInt(PACKET_SEQUENCE_FLAGS, SEQ_INCREMENTAL_STATE_CLEARED);
+            first_packet = false;
+        }
+        trace.Message(TRACE_PACKET, packet);
+    };
+    auto slice = [&emit](uint64_t track, uint64_t timestamp, uint64_t type, const char* name) {
+        ProtoWriter event;
+        event.UInt(EVENT_TYPE, type);
+        event.UInt(EVENT_TRACK_UUID, track);
+        if (name != nullptr) {
+            event.Bytes(EVENT_NAME, name);
+        }
+        ProtoWriter packet;
+        packet.UInt(PACKET_TIMESTAMP, timestamp);
+        packet.Message(PACKET_TRACK_EVENT, event);
+        emit(packet);
+    };
+
+    for (auto& thread : Capture()) {
+        const uint64_t track = thread.id;
+        ProtoWriter descriptor;
+        descriptor.UInt(DESCRIPTOR_UUID, track);
+        if (track == GPU_TRACK_UUID) {
+            descriptor.Bytes(DESCRIPTOR_NAME, thread.name);
+        } else {
+            ProtoWriter thread_descriptor;
+            thread_descriptor.UInt(THREAD_PID, PROCESS_ID);
+            thread_descriptor.UInt(THREAD_TID, thread.id);
+            thread_descriptor.Bytes(THREAD_NAME, thread.name);
+            descriptor.Message(DESCRIPTOR_THREAD, thread_descriptor);
+        }
+        ProtoWriter packet;
+        packet.Message(PACKET_TRACK_DESCRIPTOR, descriptor);
+        emit(packet);
+
+        // Zones are stored in completion order; slices need begin order, outer zones first on ties.
+        std::sort(thread.events.begin(), thread.events.end(), [](const ZoneEvent& a, const ZoneEvent& b) {
+            return a.begin != b.begin ? a.begin < b.begin : a.end > b.end;
+        });
+        std::vector<uint64_t> open_ends;
+        for (const auto& event : thread.events) {
+            while (!open_ends.empty() && open_ends.back() <= event.begin) {
+                slice(track, open_ends.back(), TYPE_SLICE_END, nullptr);
+                open_ends.pop_back();
+            }
+            slice(track, event.begin, TYPE_SLICE_BEGIN, event.name);
+            open_ends.push_back(std::max(event.end, event.begin));
+        }
+        while (!open_ends.empty()) {
+            slice(track, open_ends.back(), TYPE_SLICE_END, nullptr);
+            open_ends.pop_back();
+        }
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open trace " + path.string() + ".");
+    }
+    file.write(trace.Data().data(), static_cast<std::streamsize>(trace.Data().size()));
+}
+
+void CpuProfiler::Export(const std::filesystem::path& path) {
+    if (path.extension() == ".json") {
+        ExportChromeTrace(path);
+    } else {
+        ExportPerfetto(path);
+    }
+}
+
+CpuProfiler::ThreadBuffer& CpuProfiler::LocalBuffer() {
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (buffer == nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto created = std::make_unique<ThreadBuffer>();
+        created->id = static_cast<uint32_t>(buffers_.size());
+        created->name = "thread " + std::to_string(created->id);
+        buffer = created.get();
+        buffers_.push_back(std::move(created));
+    }
+    return *buffer;
+}
+
+void CpuProfiler::Push(ThreadBuffer& buffer, const ZoneEvent& event) {
+    const auto head = buffer.head.load(std::memory_order_relaxed);
+    buffer.events[head % CAPACITY_] = event;
+    buffer.head.store(head + 1, std::memory_order_release);
+}
+
+std::vector<ZoneEvent> CpuProfiler::Snapshot(const ThreadBuffer& buffer) {
+    const auto head = buffer.head.load(std::memory_order_acquire);
+    const auto first = head > CAPACITY_ ? head - CAPACITY_ : 0;
+    std::vector<ZoneEvent> events;
+    events.reserve(head - first);
+    for (auto i = first; i < head; ++i) {
+        events.push_back(buffer.events[i % CAPACITY_]);
+    }
+    // The owner kept writing while we copied; drop the slots it may have overwritten meanwhile.
+    const auto after = buffer.head.load(std::memory_order_acquire);
+    const auto overwritten = after > CAPACITY_ ? after - CAPACITY_ + 1 : 0;
+    if (overwritten > first) {
+        events.erase(events.begin(), events.begin() + static_cast<std::ptrdiff_t>(std::min(overwritten - first, events.size())));
+    }
+    return events;
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,53 @@
+/**
+ * @file debug_utils.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "debug_utils.h"
+
+#if !defined(NODEBUG)
+
+namespace serenity {
+
+PFN_vkSetDebugUtilsObjectNameEXT DebugUtils::set_object_name_ = nullptr;
+PFN_vkCmdBeginDebugUtilsLabelEXT DebugUtils::begin_label_ = nullptr;
+PFN_vkCmdEndDebugUtilsLabelEXT DebugUtils::end_label_ = nullptr;
+
+void DebugUtils::Load(VkInstance instance) {
+    set_object_name_ = reinterpret_cast<PFN_vkSetDebugUtilsObjectNameEXT>(vkGetInstanceProcAddr(instance, "vkSetDebugUtilsObjectNameEXT"));
+    begin_label_ = reinterpret_cast<PFN_vkCmdBeginDebugUtilsLabelEXT>(vkGetInstanceProcAddr(instance, "vkCmdBeginDebugUtilsLabelEXT"));
+    end_label_ = reinterpret_cast<PFN_vkCmdEndDebugUtilsLabelEXT>(vkGetInstanceProcAddr(instance, "vkCmdEndDebugUtilsLabelEXT"));
+}
+
+void DebugUtils::SetObjectName(VkDevice device, VkObjectType type, uint64_t handle, const std::string& name) {
+    if (set_object_name_ == nullptr || handle == 0) {
+        return;
+    }
+    VkDebugUtilsObjectNameInfoEXT info{};
+    info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+    info.objectType = type;
+    info.objectHandle = handle;
+    info.pObjectName = name.c_str();
+    set_object_name_(device, &info);
+}
+
+void DebugUtils::BeginLabel(VkCommandBuffer command_buffer, const std::string& name) {
+    if (begin_label_ == nullptr) {
+        return;
+    }
+    VkDebugUtilsLabelEXT label{};
+    label.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+    label.pLabelName = name.c_str();
+    begin_label_(command_buffer, &label);
+}
+
+void DebugUtils::EndLabel(VkCommandBuffer command_buffer) {
+    if (end_label_ != nullptr) {
+        end_label_(command_buffer);
+    }
+}
+
+}  // namespace serenity
+
+#endif  // NODEBUG
\ No newline at end of file
@@ -0,0 +1,214 @@
+/**
+ * @file device.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "device.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "debug_utils.h"
+
+namespace serenity {
+
+Device::Device(const Instance& instance, const std::shared_ptr<spdlog::logger>& logger) : instance_(instance), logger_(logger) {
+    PickPhysicalDevice();
+    CreateLogicalDevice();
+}
+
+Device::~Device() {
+    vkDestroyDevice(device_, nullptr);
+}
+
+VkDevice Device::Handle() const {
+    return device_;
+}
+
+VkPhysicalDevice Device::PhysicalDevice() const {
+    return physical_device_;
+}
+
+VkQueue Device::GraphicsQueue() const {
+    return graphics_queue_;
+}
+
+uint32_t Device::GraphicsQueueFamily() const {
+    return graphics_queue_family_;
+}
+
+const VkPhysicalDeviceProperties& Device::Properties() const {
+    return properties_;
+}
+
+uint32_t Device::TimestampValidBits() const {
+    return timestamp_valid_bits_;
+}
+
+const VkPhysicalDeviceFeatures& Device::Features() const {
+    return features_;
+}
+
+const Instance& Device::GetInstance() const {
+    return instance_;
+}
+
+bool Device::MemoryBudgetEnabled() const {
+    return memory_budget_;
+}
+
+bool Device::MemoryPriorityEnabled() const {
+    return memory_priority_;
+}
+
+bool Device::PageableMemoryEnabled() const {
+    return pageable_memory_;
+}
+
+void Device::CountPipelineCompile() const {
+    pipeline_compiles_.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t Device::PipelineCompiles() const {
+    return pipeline_compiles_.load(std::memory_order_relaxed);
+}
+
+void Device::PickPhysicalDevice() {
+    uint32_t device_count = 0;
+    vkEnumeratePhysicalDevices(instance_.Handle(), &device_count, nullptr);
+    if (device_count == 0) {
+        throw std::runtime_error("Failed to find GPUs with Vulkan support.");
+    }
+    std::vector<VkPhysicalDevice> devices(device_count);
+    vkEnumeratePhysicalDevices(instance_.Handle(), &device_count, devices.data());
+    // Prefer a discrete GPU, but take any device with a graphics queue.
+    for (const auto& device : devices) {
+        if (!FindGraphicsQueueFamily(device).has_value()) {
+            continue;
+        }
+        VkPhysicalDeviceProperties properties{};
+        vkGetPhysicalDeviceProperties(device, &properties);
+        if (physical_device_ == nullptr || properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+            physical_device_ = device;
+            properties_ = properties;
+        }
+        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
+            break;
+        }
+    }
+    if (physical_device_ == nullptr) {
+        throw std::runtime_error("Failed to find a suitable GPU.");
+    }
+    logger_->info("Using GPU {}", static_cast<const char*>(properties_.deviceName));
+}
+
+std::optional<uint32_t> Device::FindGraphicsQueueFamily(VkPhysicalDevice physical_device) const {
+    uint32_t queue_family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, nullptr);
+    std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, queue_families.data());
+    for (uint32_t i = 0; i < queue_family_count; ++i) {
+        if (queue_families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            return i;
+        }
+    }
+    return std::nullopt;
+}
+
+bool Device::IsExtensionSupported(VkPhysicalDevice physical_device, const char* extension) const {
+    uint32_t extension_count = 0;
+    vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, nullptr);
+    std::vector<VkExtensionProperties> available_extensions(extension_count);
+    vkEnumerateDeviceExtensionProperties(physical_device, nullptr, &extension_count, available_extensions.data());
+    for (const auto& extension_properties : available_extensions) {
+        if (strcmp(extension, static_cast<const char*>(extension_properties.extensionName)) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void Device::CreateLogicalDevice() {
+    graphics_queue_family_ = FindGraphicsQueueFamily(physical_device_).value();
+    uint32_t queue_family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device_, &queue_family_count, nullptr);
+    std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(physical_device_, &queue_family_count, queue_families.data());
+    timestamp_valid_bits_ = queue_families[graphics_queue_family_].timestampValidBits;
+
+    const float queue_priority = 1.0F;
+    VkDeviceQueueCreateInfo queue_create_info{};
+    queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_create_info.queueFamilyIndex = graphics_queue_family_;
+    queue_create_info.queueCount = 1;
+    queue_create_info.pQueuePriorities = &queue_priority;
+
+    std::vector<const char*> extensions;
+    // Portability implementations (MoltenVK) require the subset extension to be enabled when it is exposed. Its
+    // name macro lives in vulkan_beta.h, which is only included with VK_ENABLE_BETA_EXTENSIONS.
+    constexpr const char* PORTABILITY_SUBSET_EXTENSION = "VK_KHR_portability_subset";
+    if (IsExtensionSupported(physical_device_, PORTABILITY_SUBSET_EXTENSION)) {
+        extensions.push_back(PORTABILITY_SUBSET_EXTENSION);
+    }
+    if (IsExtensionSupported(physical_device_, VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+        extensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+        memory_budget_ = true;
+    }
+
+    // Memory priorities let the driver page out low-priority allocations first instead of failing or thrashing.
+    VkPhysicalDevicePageableDeviceLocalMemoryFeaturesEXT pageable_features{};
+    pageable_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PAGEABLE_DEVICE_LOCAL_MEMORY_FEATURES_EXT;
+    VkPhysicalDeviceMemoryPriorityFeaturesEXT priority_features{};
+    priority_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PRIORITY_FEATURES_EXT;
+    priority_features.pNext = &pageable_features;
+    auto get_features2 = reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(instance_.Handle(), "vkGetPhysicalDeviceFeatures2KHR"));
+    if (get_features2 != nullptr && IsExtensionSupported(physical_device_, VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME)) {
+        VkPhysicalDeviceFeatures2 features2{};
+        features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+        features2.pNext = &priority_features;
+        get_features2(physical_device_, &features2);
+        memory_priority_ = priority_features.memoryPriority == VK_TRUE;
+        pageable_memory_ = memory_priority_ && pageable_features.pageableDeviceLocalMemory == VK_TRUE && IsExtensionSupported(physical_device_, VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+    }
+    // Feature structs may only be chained into device creation alongside their extensions.
+    priority_features.memoryPriority = memory_priority_ ? VK_TRUE : VK_FALSE;
+    priority_features.pNext = pageable_memory_ ? &pageable_features : nullptr;
+    pageable_features.pageableDeviceLocalMemory = pageable_memory_ ? VK_TRUE : VK_FALSE;
+    if (memory_priority_) {
+        extensions.push_back(VK_EXT_MEMORY_PRIORITY_EXTENSION_NAME);
+    }
+    if (pageable_memory_) {
+        extensions.push_back(VK_EXT_PAGEABLE_DEVICE_LOCAL_MEMORY_EXTENSION_NAME);
+    }
+
+    // Query instrumentation features are cheap to enable and only used when asked for.
+    VkPhysicalDeviceFeatures supported_features{};
+    vkGetPhysicalDeviceFeatures(physical_device_, &supported_features);
+    features_.pipelineStatisticsQuery = supported_features.pipelineStatisticsQuery;
+    features_.occlusionQueryPrecise = supported_features.occlusionQueryPrecise;
+
+    VkDeviceCreateInfo create_info{};
+    create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    create_info.pNext = memory_priority_ ? &priority_features : nullptr;
+    create_info.queueCreateInfoCount = 1;
+    create_info.pQueueCreateInfos = &queue_create_info;
+    create_info.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    create_info.ppEnabledExtensionNames = extensions.data();
+    create_info.pEnabledFeatures = &features_;
+    if (instance_.ValidationLayersEnabled()) {
+        create_info.enabledLayerCount = static_cast<uint32_t>(instance_.ValidationLayers().size());
+        create_info.ppEnabledLayerNames = instance_.ValidationLayers().data();
+    } else {
+        create_info.enabledLayerCount = 0;
+    }
+
+    if (vkCreateDevice(physical_device_, &create_info, nullptr, &device_) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create logical device.");
+    }
+    vkGetDeviceQueue(device_, graphics_queue_family_, 0, &graphics_queue_);
+    SERENITY_DEBUG_NAME(device_, VK_OBJECT_TYPE_DEVICE, device_, "Serenity device");
+    SERENITY_DEBUG_NAME(device_, VK_OBJECT_TYPE_QUEUE, graphics_queue_, "Graphics queue");
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,301 @@
+/**
+ * @file ecs.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "ecs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+namespace serenity {
+
+namespace {
+
+constexpr size_t CHUNK_ALIGNMENT = 64;
+
+size_t AlignUp(size_t offset, size_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+std::array<ComponentInfo, MAX_COMPONENTS> component_infos{};
+std::atomic<ComponentId> component_count{0};
+std::mutex component_mutex{};
+
+}  // namespace
+
+const ComponentInfo& Components::Info(ComponentId id) {
+    return component_infos[id];
+}
+
+ComponentId Components::Register(const ComponentInfo& info) {
+    std::lock_guard<std::mutex> lock(component_mutex);
+    const auto id = component_count.load();
+    if (id >= MAX_COMPONENTS) {
+        throw std::runtime_error("Too many component types, raise MAX_COMPONENTS.");
+    }
+    if (info.alignment > CHUNK_ALIGNMENT) {
+        throw std::runtime_error("Component alignment exceeds the chunk alignment.");
+    }
+    component_infos[id] = info;
+    component_count = id + 1;
+    return id;
+}
+
+Archetype::Archetype(const ComponentMask& mask) : mask_(mask) {
+    for (ComponentId id = 0; id < MAX_COMPONENTS; ++id) {
+        if (mask_.test(id)) {
+            components_.push_back(id);
+        }
+    }
+    // Larger alignments first keeps padding between the arrays to a minimum.
+    std::vector<ComponentId> layout(components_);
+    std::stable_sort(layout.begin(), layout.end(), [](ComponentId a, ComponentId b) {
+        return Components::Info(a).alignment > Components::Info(b).alignment;
+    });
+    size_t row_bytes = sizeof(Entity);
+    for (auto id : components_) {
+        row_bytes += Components::Info(id).size;
+    }
+    // Start from the padding-free estimate and shrink until the aligned arrays fit in a chunk.
+    for (capacity_ = CHUNK_BYTES / row_bytes; capacity_ > 0; --capacity_) {
+        size_t offset = sizeof(Entity) * capacity_;
+        for (auto id : layout) {
+            const auto& info = Components::Info(id);
+            offset = AlignUp(offset, info.alignment);
+            offsets_[id] = offset;
+            offset += info.size * capacity_;
+        }
+        if (offset <= CHUNK_BYTES) {
+            break;
+        }
+    }
+    if (capacity_ == 0) {
+        throw std::runtime_error("Archetype components do not fit in a chunk.");
+    }
+}
+
+Archetype::~Archetype() {
+    for (size_t row = 0; row < size_; ++row) {
+        for (auto id : components_) {
+            Components::Info(id).destroy(Component(id, row));
+        }
+    }
+}
+
+const ComponentMask& Archetype::Mask() const {
+    return mask_;
+}
+
+const std::vector<ComponentId>& Archetype::ComponentIds() const {
+    return components_;
+}
+
+bool Archetype::Has(ComponentId id) const {
+    return mask_.test(id);
+}
+
+size_t Archetype::Size() const {
+    return size_;
+}
+
+size_t Archetype::ChunkCapacity() const {
+    return capacity_;
+}
+
+size_t Archetype::ChunkCount() const {
+    return chunks_.size();
+}
+
+size_t Archetype::ChunkSize(size_t chunk) const {
+    return chunks_[chunk].size;
+}
+
+std::byte* Archetype::ChunkData(size_t chunk) const {
+    return chunks_[chunk].memory.get();
+}
+
+size_t Archetype::Offset(ComponentId id) const {
+    return offsets_[id];
+}
+
+Entity* Archetype::Entities(size_t chunk) const {
+    return reinterpret_cast<Entity*>(chunks_[chunk].memory.get());
+}
+
+void* Archetype::Component(ComponentId id, size_t row) const {
+    return chunks_[row / capacity_].memory.get() + offsets_[id] + Components::Info(id).size * (row % capacity_);
+}
+
+size_t Archetype::Push(Entity entity) {
+    if (chunks_.empty() || chunks_.back().size == capacity_) {
+        auto* memory = static_cast<std::byte*>(::operator new(CHUNK_BYTES, std::align_val_t{CHUNK_ALIGNMENT}));
+        chunks_.push_back({std::unique_ptr<std::byte[], ChunkDeleter>(memory), 0});
+    }
+    auto& chunk = chunks_.back();
+    new (reinterpret_cast<Entity*>(chunk.memory.get()) + chunk.size) Entity(entity);
+    ++chunk.size;
+    return size_++;
+}
+
+Entity Archetype::Erase(size_t row) {
+    const auto last = size_ - 1;
+    Entity moved{};
+    for (auto id : components_) {
+        const auto& info = Components::Info(id);
+        auto* hole = Component(id, row);
+        info.destroy(hole);
+        if (row != last) {
+            auto* tail = Component(id, last);
+            info.move_construct(hole, tail);
+            info.destroy(tail);
+        }
+    }
+    if (row != last) {
+        moved = Entities(last / capacity_)[last % capacity_];
+        Entities(row / capacity_)[row % capacity_] = moved;
+    }
+    --size_;
+    if (--chunks_.back().size == 0) {
+        chunks_.pop_back();
+    }
+    return moved;
+}
+
+Archetype*& Archetype::AddEdge(ComponentId id) {
+    return add_edges_[id];
+}
+
+Archetype*& Archetype::RemoveEdge(ComponentId id) {
+    return remove_edges_[id];
+}
+
+void Archetype::ChunkDeleter::operator()(std::byte* memory) const {
+    ::operator delete(memory, std::align_val_t{CHUNK_ALIGNMENT});
+}
+
+World::World() {
+    FindOrCreate(ComponentMask{});
+}
+
+void World::Destroy(Entity entity) {
+    CheckAlive(entity);
+    auto& location = locations_[entity.index];
+    const auto moved = location.archetype->Erase(location.row);
+    if (moved.Valid()) {
+        locations_[moved.index].row = location.row;
+    }
+    location = {};
+    ++generations_[entity.index];
+    free_.push_back(entity.index);
+    --size_;
+}
+
+bool World::Alive(Entity entity) const {
+    return entity.index < generations_.size() && generations_[entity.index] == entity.generation && locations_[entity.index].archetype != nullptr;
+}
+
+size_t World::Size() const {
+    return size_;
+}
+
+size_t World::ArchetypeCount() const {
+    return archetypes_.size();
+}
+
+Archetype& World::FindOrCreate(const ComponentMask& mask) {
+    auto iter = lookup_.find(mask);
+    if (iter != lookup_.end()) {
+        return *iter->second;
+    }
+    archetypes_.push_back(std::make_unique<Archetype>(mask));
+    lookup_.emplace(mask, archetypes_.back().get());
+    return *archetypes_.back();
+}
+
+Entity World::Allocate() {
+    ++size_;
+    if (!free_.empty()) {
+        const auto index = free_.back();
+        free_.pop_back();
+        return {index, generations_[index]};
+    }
+    const auto index = static_cast<uint32_t>(generations_.size());
+    generations_.push_back(0);
+    locations_.emplace_back();
+    return {index, 0};
+}
+
+void World::CheckAlive(Entity entity) const {
+    if (!Alive(entity)) {
+        throw std::runtime_error("Entity " + std::to_string(entity.index) + " is not alive.");
+    }
+}
+
+void World::Relocate(Entity entity, Archetype& target) {
+    auto& location = locations_[entity.index];
+    auto& source = *location.archetype;
+    const auto row = target.Push(entity);
+    for (auto id : target.ComponentIds()) {
+        if (source.Has(id)) {
+            Components::Info(id).move_construct(target.Component(id, row), source.Component(id, location.row));
+        }
+    }
+    const auto moved = source.Erase(location.row);
+    if (moved.Valid()) {
+        locations_[moved.index].row = location.row;
+    }
+    location = {&target, row};
+}
+
+void SystemScheduler::Run(World& world, ThreadPool& pool) {
+    if (stages_.empty()) {
+        Plan();
+    }
+    for (const auto& stage : stages_) {
+        pool.ParallelFor(stage.size(), [this, &stage, &world, &pool](size_t index) {
+            systems_[stage[index]].run(world, pool);
+        });
+    }
+}
+
+std::vector<std::vector<std::string>> SystemScheduler::Stages() {
+    if (stages_.empty()) {
+        Plan();
+    }
+    std::vector<std::vector<std::string>> names;
+    for (const auto& stage : stages_) {
+        auto& stage_names = names.emplace_back();
+        for (auto index : stage) {
+            stage_names.push_back(systems_[index].name);
+        }
+    }
+    return names;
+}
+
+bool SystemScheduler::Conflicts(const System& a, const System& b) {
+    return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+}
+
+void SystemScheduler::Plan() {
+    stages_.clear();
+    std::vector<size_t> stage_of(systems_.size(), 0);
+    for (size_t i = 0; i < systems_.size(); ++i) {
+        // A system goes right after the latest earlier system it conflicts with, so conflicting systems keep their order.
+        size_t stage = 0;
+        for (size_t j = 0; j < i; ++j) {
+            if (Conflicts(systems_[i], systems_[j])) {
+                stage = std::max(stage, stage_of[j] + 1);
+            }
+        }
+        stage_of[i] = stage;
+        if (stages_.size() <= stage) {
+            stages_.resize(stage + 1);
+        }
+        stages_[stage].push_back(i);
+    }
+}
+
+}  // namespace serenity
\ No newline at end of file
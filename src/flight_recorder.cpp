@@ -0,0 +1,398 @@
+/**
+ * @file flight_recorder.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "flight_recorder.h"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#endif
+
+#include "cpu_profiler.h"
+#include "json.hpp"
+#include "spdlog/sinks/base_sink.h"
+
+namespace serenity {
+
+namespace {
+
+constexpr int PROCESS_ID = 1;
+constexpr int FRAME_TRACK = 1;
+constexpr int GPU_TRACK = 2;
+constexpr int MEMORY_TRACK = 3;
+constexpr int LOG_TRACK = 4;
+
+// The crash dump around the ring's fragments, each of which starts with a comma. Track names match Serialize().
+constexpr char CRASH_HEADER[] =
+    R"({"traceEvents":[{"name":"thread_name","ph":"M","pid":1,"tid":1,"args":{"name":"Frames"}},)"
+    R"({"name":"thread_name","ph":"M","pid":1,"tid":2,"args":{"name":"GPU"}},)"
+    R"({"name":"thread_name","ph":"M","pid":1,"tid":3,"args":{"name":"Allocations"}},)"
+    R"({"name":"thread_name","ph":"M","pid":1,"tid":4,"args":{"name":"Log"}})";
+constexpr char CRASH_FOOTER[] = R"(],"displayTimeUnit":"ms","otherData":{"reason":"crash"}})";
+
+#if defined(_WIN32)
+constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL};
+using CrashAction = void (*)(int);
+#else
+constexpr int CRASH_SIGNALS[] = {SIGSEGV, SIGABRT, SIGFPE, SIGILL, SIGBUS};
+using CrashAction = struct sigaction;
+#endif
+
+// Whatever was installed before InstallCrashHandler(), by index into CRASH_SIGNALS.
+CrashAction previous_actions[std::size(CRASH_SIGNALS)]{};
+
+size_t CrashSignalIndex(int signal) {
+    size_t index = 0;
+    while (index + 1 < std::size(CRASH_SIGNALS) && CRASH_SIGNALS[index] != signal) {
+        ++index;
+    }
+    return index;
+}
+
+void Write(const std::filesystem::path& path, const std::string& trace) {
+    std::ofstream file(path, std::ios::binary);
+    file << trace;
+}
+
+// Escapes text into out as the inside of a JSON string, cutting it short rather than overflowing. Control characters,
+// such as the line end a log formatter appends, become spaces.
+void EscapeJson(std::string_view text, char* out, size_t capacity) {
+    size_t length = 0;
+    for (const auto c : text) {
+        const auto escaped = c == '"' || c == '\\';
+        if (length + (escaped ? 2 : 1) >= capacity) {
+            break;
+        }
+        if (escaped) {
+            out[length++] = '\\';
+        }
+        out[length++] = static_cast<unsigned char>(c) < 0x20 ? ' ' : c;
+    }
+    out[length] = '\0';
+}
+
+// Signal handler I/O: async-signal-safe calls only, nothing that allocates or locks.
+int OpenCrashFile(const char* path) {
+#if defined(_WIN32)
+    return _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    return open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+}
+
+void WriteCrashFile(int file, const char* data, size_t size) {
+    size_t written = 0;
+    while (written < size) {
+#if defined(_WIN32)
+        const auto result = _write(file, data + written, static_cast<unsigned int>(size - written));
+#else
+        const auto result = write(file, data + written, size - written);
+#endif
+        if (result <= 0) {
+            return;
+        }
+        written += static_cast<size_t>(result);
+    }
+}
+
+void CloseCrashFile(int file) {
+#if defined(_WIN32)
+    _close(file);
+#else
+    close(file);
+#endif
+}
+
+// Feeds formatted lines to the recorder, which keeps them for hitch dumps and the crash ring.
+class RecorderSink final : public spdlog::sinks::base_sink<std::mutex> {
+protected:
+    void sink_it_(const spdlog::details::log_msg& message) override {
+        spdlog::memory_buf_t formatted;
+        formatter_->format(message, formatted);
+        FlightRecorder::Get().RecordLog(std::string_view(formatted.data(), formatted.size()));
+    }
+
+    void flush_() override {
+    }
+};
+
+}  // namespace
+
+FlightRecorder& FlightRecorder::Get() {
+    static FlightRecorder recorder;
+    return recorder;
+}
+
+FlightRecorder::FlightRecorder() : origin_(Clock::now()), log_sink_(std::make_shared<RecorderSink>()) {
+}
+
+void FlightRecorder::Configure(double window, double hitch_budget, const std::filesystem::path& directory) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    window_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(window));
+    hitch_budget_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(hitch_budget));
+    directory_ = directory;
+    if (crash_events_) {
+        PublishCrashPath();
+    }
+}
+
+std::shared_ptr<spdlog::sinks::sink> FlightRecorder::LogSink() const {
+    return log_sink_;
+}
+
+void FlightRecorder::InstallCrashHandler() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Installing twice would chain the handler to itself.
+        if (crash_events_) {
+            return;
+        }
+        crash_events_ = std::make_unique<CrashEvent[]>(CRASH_EVENTS_);
+        PublishCrashPath();
+    }
+    for (size_t i = 0; i < std::size(CRASH_SIGNALS); ++i) {
+#if defined(_WIN32)
+        previous_actions[i] = std::signal(CRASH_SIGNALS[i], &FlightRecorder::OnCrash);
+#else
+        struct sigaction action {};
+        action.sa_sigaction = &FlightRecorder::OnCrash;
+        action.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        sigemptyset(&action.sa_mask);
+        sigaction(CRASH_SIGNALS[i], &action, &previous_actions[i]);
+#endif
+    }
+}
+
+void FlightRecorder::RecordZone(const char* name, Clock::time_point begin, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    zones_.push_back({name, begin, end});
+    Trim(end);
+    if (auto* event = BeginCrashEvent()) {
+        char escaped[64];
+        EscapeJson(name, escaped, sizeof(escaped));
+        EndCrashEvent(event, std::snprintf(event->text, CRASH_EVENT_BYTES_, R"(,{"name":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":%d,"tid":%d})", escaped, Micros(begin), Micros(end) - Micros(begin), PROCESS_ID, FRAME_TRACK));
+    }
+}
+
+void FlightRecorder::RecordGpuPass(const std::string& name, double milliseconds) {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    gpu_passes_.push_back({name, now, milliseconds});
+    Trim(now);
+    if (auto* event = BeginCrashEvent()) {
+        char escaped[64];
+        EscapeJson(name, escaped, sizeof(escaped));
+        const auto duration = milliseconds * 1e3;
+        EndCrashEvent(event, std::snprintf(event->text, CRASH_EVENT_BYTES_, R"(,{"name":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":%d,"tid":%d})", escaped, Micros(now) - duration, duration, PROCESS_ID, GPU_TRACK));
+    }
+}
+
+void FlightRecorder::RecordAllocation(const char* category, uint32_t heap, int64_t bytes) {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& total = allocated_[category];
+    total += bytes;
+    allocations_.push_back({category, heap, now, bytes, total});
+    Trim(now);
+    if (auto* event = BeginCrashEvent()) {
+        char escaped[32];
+        EscapeJson(category, escaped, sizeof(escaped));
+        const auto ts = Micros(now);
+        EndCrashEvent(event, std::snprintf(event->text, CRASH_EVENT_BYTES_, R"(,{"name":"%s","ph":"i","s":"t","ts":%.3f,"pid":%d,"tid":%d,"args":{"heap":%u,"bytes":%lld}},{"name":"allocated_bytes","ph":"C","ts":%.3f,"pid":%d,"args":{"%s":%lld}})", escaped, ts, PROCESS_ID, MEMORY_TRACK, heap, static_cast<long long>(bytes), ts, PROCESS_ID, escaped, static_cast<long long>(total)));
+    }
+}
+
+void FlightRecorder::RecordLog(std::string_view line) {
+    const auto now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (logs_.size() == LOG_LINES_) {
+        logs_.pop_front();
+    }
+    logs_.emplace_back(line);
+    if (auto* event = BeginCrashEvent()) {
+        char escaped[160];
+        EscapeJson(line, escaped, sizeof(escaped));
+        EndCrashEvent(event, std::snprintf(event->text, CRASH_EVENT_BYTES_, R"(,{"name":"log","ph":"i","s":"t","ts":%.3f,"pid":%d,"tid":%d,"args":{"line":"%s"}})", Micros(now), PROCESS_ID, LOG_TRACK, escaped));
+    }
+}
+
+std::filesystem::path FlightRecorder::EndFrame(Clock::time_point begin, Clock::time_point end) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    zones_.push_back({"Frame", begin, end});
+    Trim(end);
+    if (auto* event = BeginCrashEvent()) {
+        EndCrashEvent(event, std::snprintf(event->text, CRASH_EVENT_BYTES_, R"(,{"name":"Frame","ph":"X","ts":%.3f,"dur":%.3f,"pid":%d,"tid":%d})", Micros(begin), Micros(end) - Micros(begin), PROCESS_ID, FRAME_TRACK));
+    }
+    if (hitch_budget_.count() == 0 || end - begin <= hitch_budget_) {
+        return {};
+    }
+    // One dump per window is enough to cover a burst of hitches, and keeps a stuttering game from flooding the disk.
+    if (last_dump_ != Clock::time_point{} && end - last_dump_ < window_) {
+        return {};
+    }
+    if (writer_.valid() && writer_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return {};
+    }
+    last_dump_ = end;
+    const auto path = NextPath("hitch");
+    auto capture = Snapshot();
+    lock.unlock();
+    writer_ = std::async(std::launch::async, [path, capture = std::move(capture)]() {
+        Write(path, Serialize(capture, "hitch"));
+#if defined(SERENITY_ENABLE_PROFILING)
+        CpuProfiler::Get().ExportChromeTrace(std::filesystem::path(path).replace_extension(".cpu.json"));
+#endif  // SERENITY_ENABLE_PROFILING
+    });
+    return path;
+}
+
+std::filesystem::path FlightRecorder::Dump(const std::string& reason) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const auto path = NextPath(reason);
+    const auto capture = Snapshot();
+    lock.unlock();
+    Write(path, Serialize(capture, reason));
+    return path;
+}
+
+void FlightRecorder::Trim(Clock::time_point now) {
+    const auto oldest = now - window_;
+    while (!zones_.empty() && zones_.front().end < oldest) {
+        zones_.pop_front();
+    }
+    while (!gpu_passes_.empty() && gpu_passes_.front().time < oldest) {
+        gpu_passes_.pop_front();
+    }
+    while (!allocations_.empty() && allocations_.front().time < oldest) {
+        allocations_.pop_front();
+    }
+}
+
+FlightRecorder::Capture FlightRecorder::Snapshot() const {
+    return {origin_, {zones_.begin(), zones_.end()}, {gpu_passes_.begin(), gpu_passes_.end()}, {allocations_.begin(), allocations_.end()}, {logs_.begin(), logs_.end()}};
+}
+
+std::string FlightRecorder::Serialize(const Capture& capture, const std::string& reason) {
+    auto micros = [&capture](Clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(time - capture.origin).count();
+    };
+    auto events = nlohmann::json::array();
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", PROCESS_ID}, {"tid", FRAME_TRACK}, {"args", {{"name", "Frames"}}}});
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", PROCESS_ID}, {"tid", GPU_TRACK}, {"args", {{"name", "GPU"}}}});
+    events.push_back({{"name", "thread_name"}, {"ph", "M"}, {"pid", PROCESS_ID}, {"tid", MEMORY_TRACK}, {"args", {{"name", "Allocations"}}}});
+    for (const auto& zone : capture.zones) {
+        events.push_back({{"name", zone.name}, {"ph", "X"}, {"ts", micros(zone.begin)}, {"dur", micros(zone.end) - micros(zone.begin)}, {"pid", PROCESS_ID}, {"tid", FRAME_TRACK}});
+    }
+    // Only the duration of a GPU pass is known here, so it is drawn as ending when its result was read back.
+    for (const auto& pass : capture.gpu_passes) {
+        const auto duration = pass.milliseconds * 1e3;
+        events.push_back({{"name", pass.name}, {"ph", "X"}, {"ts", micros(pass.time) - duration}, {"dur", duration}, {"pid", PROCESS_ID}, {"tid", GPU_TRACK}});
+    }
+    for (const auto& allocation : capture.allocations) {
+        events.push_back({{"name", allocation.category}, {"ph", "i"}, {"s", "t"}, {"ts", micros(allocation.time)}, {"pid", PROCESS_ID}, {"tid", MEMORY_TRACK}, {"args", {{"heap", allocation.heap}, {"bytes", allocation.bytes}}}});
+        events.push_back({{"name", "allocated_bytes"}, {"ph", "C"}, {"ts", micros(allocation.time)}, {"pid", PROCESS_ID}, {"args", {{allocation.category, allocation.total}}}});
+    }
+    nlohmann::json trace{{"traceEvents", std::move(events)}, {"displayTimeUnit", "ms"}};
+    trace["otherData"] = {{"reason", reason}, {"logs", capture.logs}};
+    return trace.dump(-1, ' ', false, nlohmann::json::error_handler_t::replace);
+}
+
+std::filesystem::path FlightRecorder::NextPath(const std::string& reason) const {
+    const auto stamp = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return directory_ / ("flight_" + reason + "_" + std::to_string(stamp) + ".json");
+}
+
+double FlightRecorder::Micros(Clock::time_point time) const {
+    return std::chrono::duration<double, std::micro>(time - origin_).count();
+}
+
+void FlightRecorder::PublishCrashPath() {
+    // The path is fixed ahead of time; the handler cannot build one.
+    auto& path = crash_path_.load() == &crash_paths_[0] ? crash_paths_[1] : crash_paths_[0];
+    path = NextPath("crash").string();
+    crash_path_.store(&path);
+}
+
+FlightRecorder::CrashEvent* FlightRecorder::BeginCrashEvent() {
+    if (!crash_events_) {
+        return nullptr;
+    }
+    auto& event = crash_events_[crash_event_count_.load(std::memory_order_relaxed) % CRASH_EVENTS_];
+    event.length.store(0, std::memory_order_release);
+    return &event;
+}
+
+void FlightRecorder::EndCrashEvent(CrashEvent* event, int length) {
+    // A fragment snprintf() had to cut short is not valid JSON; leave the slot empty instead.
+    if (length > 0 && static_cast<size_t>(length) < CRASH_EVENT_BYTES_) {
+        event->length.store(static_cast<uint32_t>(length), std::memory_order_release);
+    }
+    crash_event_count_.store(crash_event_count_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+#if defined(_WIN32)
+void FlightRecorder::OnCrash(int signal) {
+    Get().WriteCrashDump();
+    const auto previous = previous_actions[CrashSignalIndex(signal)];
+    std::signal(signal, previous == SIG_ERR ? SIG_DFL : previous);
+    std::raise(signal);
+}
+#else
+void FlightRecorder::OnCrash(int signal, siginfo_t* info, void* context) {
+    Get().WriteCrashDump();
+    // Hand the signal on to the previous handler, which stays installed should the fault repeat.
+    const auto& previous = previous_actions[CrashSignalIndex(signal)];
+    sigaction(signal, &previous, nullptr);
+    if ((previous.sa_flags & SA_SIGINFO) != 0) {
+        previous.sa_sigaction(signal, info, context);
+    } else if (previous.sa_handler == SIG_IGN) {
+        // Returning from an ignored fault would only fault again.
+        _exit(128 + signal);
+    } else if (previous.sa_handler != SIG_DFL) {
+        previous.sa_handler(signal);
+    } else {
+        // Blocked while this handler runs, so the default action takes over as soon as it returns.
+        raise(signal);
+    }
+}
+#endif
+
+void FlightRecorder::WriteCrashDump() const {
+    const auto* path = crash_path_.load();
+    if (path == nullptr) {
+        return;
+    }
+    const auto file = OpenCrashFile(path->c_str());
+    if (file < 0) {
+        return;
+    }
+    WriteCrashFile(file, CRASH_HEADER, sizeof(CRASH_HEADER) - 1);
+    // Oldest first; slots being rewritten read as empty.
+    const auto count = crash_event_count_.load(std::memory_order_acquire);
+    for (auto i = count > CRASH_EVENTS_ ? count - CRASH_EVENTS_ : 0; i < count; ++i) {
+        const auto& event = crash_events_[i % CRASH_EVENTS_];
+        const auto length = event.length.load(std::memory_order_acquire);
+        if (length > 0) {
+            WriteCrashFile(file, event.text, length);
+        }
+    }
+    WriteCrashFile(file, CRASH_FOOTER, sizeof(CRASH_FOOTER) - 1);
+    CloseCrashFile(file);
+}
+
+}  // namespace serenity
\ No newline at end of file
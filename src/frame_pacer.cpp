@@ -0,0 +1,121 @@
+/**
+ * @file frame_pacer.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "frame_pacer.h"
+
+#include <stdexcept>
+#include <thread>
+
+namespace serenity {
+
+FramePacer::FramePacer(double target_frame_time, uint32_t max_queued_frames, const std::shared_ptr<spdlog::logger>& logger) : logger_(logger) {
+    SetTargetFrameTime(target_frame_time);
+    SetMaxQueuedFrames(max_queued_frames);
+}
+
+void FramePacer::SetTargetFrameTime(double target_frame_time) {
+    if (target_frame_time < 0.0) {
+        throw std::runtime_error("Target frame time must not be negative.");
+    }
+    target_frame_time_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(target_frame_time));
+    deadline_ = Clock::now();
+}
+
+void FramePacer::SetMaxQueuedFrames(uint32_t max_queued_frames) {
+    if (max_queued_frames == 0) {
+        throw std::runtime_error("At least one frame must be allowed in the presentation queue.");
+    }
+    max_queued_frames_ = max_queued_frames;
+}
+
+void FramePacer::SetPresentWaiter(PresentWaiter waiter) {
+    present_waiter_ = std::move(waiter);
+}
+
+void FramePacer::SetEventWaiter(EventWaiter waiter) {
+    event_waiter_ = std::move(waiter);
+}
+
+void FramePacer::BeginFrame() {
+    WaitForPresent();
+    WaitForDeadline();
+}
+
+void FramePacer::EndFrame(std::optional<Clock::time_point> input_time) {
+    ++present_id_;
+    if (input_time.has_value()) {
+        if (present_waiter_) {
+            pending_inputs_.emplace_back(present_id_, *input_time);
+        } else {
+            RecordLatency(*input_time, Clock::now());
+        }
+    }
+    if (++frames_since_report_ >= REPORT_INTERVAL_ && !latencies_.Empty()) {
+        const auto latency = InputLatency();
+        logger_->info("Input latency over {} samples: p50 {:.3f} ms, p90 {:.3f} ms, p99 {:.3f} ms", latency.samples, latency.p50, latency.p90, latency.p99);
+        frames_since_report_ = 0;
+    }
+}
+
+uint64_t FramePacer::PresentId() const {
+    return present_id_ + 1;
+}
+
+uint32_t FramePacer::MaxQueuedFrames() const {
+    return max_queued_frames_;
+}
+
+LatencyPercentiles FramePacer::InputLatency() const {
+    return {latencies_.Percentile(50.0), latencies_.Percentile(90.0), latencies_.Percentile(99.0), latencies_.Size()};
+}
+
+void FramePacer::WaitForPresent() {
+    if (!present_waiter_ || present_id_ < max_queued_frames_) {
+        return;
+    }
+    // Keep at most max_queued_frames_ frames between submission and the display.
+    const auto target = present_id_ + 1 - max_queued_frames_;
+    if (target <= presented_id_ || !present_waiter_(target, PRESENT_TIMEOUT_)) {
+        return;
+    }
+    presented_id_ = target;
+    const auto now = Clock::now();
+    while (!pending_inputs_.empty() && pending_inputs_.front().first <= target) {
+        RecordLatency(pending_inputs_.front().second, now);
+        pending_inputs_.pop_front();
+    }
+}
+
+void FramePacer::WaitForDeadline() {
+    if (target_frame_time_.count() == 0) {
+        return;
+    }
+    auto now = Clock::now();
+    if (now < deadline_) {
+        // Sleep for the bulk of the wait, then spin the last stretch the scheduler cannot hit precisely. Waiting on
+        // events instead of sleeping stamps input that arrives meanwhile with its arrival time.
+        const auto wake = deadline_ - SPIN_MARGIN_;
+        if (event_waiter_) {
+            for (; now < wake; now = Clock::now()) {
+                event_waiter_(wake - now);
+            }
+        } else if (now < wake) {
+            std::this_thread::sleep_until(wake);
+        }
+        while (Clock::now() < deadline_) {
+            std::this_thread::yield();
+        }
+        now = deadline_;
+    }
+    // Anchor on the actual start after a long frame instead of rushing several short frames to catch up.
+    deadline_ = now + target_frame_time_;
+}
+
+void FramePacer::RecordLatency(Clock::time_point input_time, Clock::time_point present_time) {
+    latencies_.Add(std::chrono::duration<double, std::milli>(present_time - input_time).count());
+}
+
+}  // namespace serenity
\ No newline at end of file
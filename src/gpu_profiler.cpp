@@ -0,0 +1,149 @@
+/**
+ * @file gpu_profiler.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "gpu_profiler.h"
+
+#include <stdexcept>
+
+#include "cpu_profiler.h"
+#include "debug_utils.h"
+#include "flight_recorder.h"
+
+namespace serenity {
+
+GpuProfiler::GpuProfiler(const Device& device, uint32_t frames_in_flight, uint32_t max_passes, const std::shared_ptr<spdlog::logger>& logger) : device_(device), query_capacity_(max_passes * 2), logger_(logger) {
+    const auto valid_bits = device_.TimestampValidBits();
+    if (valid_bits == 0) {
+        logger_->warn("Graphics queue does not support timestamps, GPU profiling disabled");
+        return;
+    }
+    timestamp_mask_ = valid_bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << valid_bits) - 1;
+    timestamp_period_ = static_cast<double>(device_.Properties().limits.timestampPeriod);
+
+    VkQueryPoolCreateInfo create_info{};
+    create_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    create_info.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    create_info.queryCount = query_capacity_;
+    frames_.resize(frames_in_flight);
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        if (vkCreateQueryPool(device_.Handle(), &create_info, nullptr, &frames_[i].query_pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create timestamp query pool.");
+        }
+        SERENITY_DEBUG_NAME(device_.Handle(), VK_OBJECT_TYPE_QUERY_POOL, frames_[i].query_pool, "GPU timestamps " + std::to_string(i));
+    }
+    enabled_ = true;
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (auto& frame : frames_) {
+        if (frame.query_pool != nullptr) {
+            vkDestroyQueryPool(device_.Handle(), frame.query_pool, nullptr);
+        }
+    }
+}
+
+void GpuProfiler::BeginFrame(VkCommandBuffer command_buffer, uint32_t frame_index) {
+    if (!enabled_) {
+        return;
+    }
+    current_ = &frames_[frame_index % frames_.size()];
+    CollectResults(*current_);
+    current_->cpu_ticks = CpuProfiler::Now();
+    vkCmdResetQueryPool(command_buffer, current_->query_pool, 0, query_capacity_);
+    if (++frames_since_report_ >= REPORT_INTERVAL_) {
+        Report();
+        frames_since_report_ = 0;
+    }
+}
+
+void GpuProfiler::BeginPass(VkCommandBuffer command_buffer, const std::string& name) {
+    // Labels do not depend on timestamp support or query capacity, so EndPass() pops one unconditionally.
+    SERENITY_DEBUG_LABEL_BEGIN(command_buffer, name);
+    if (current_ == nullptr) {
+        return;
+    }
+    if (current_->next_query + 2 > query_capacity_) {
+        // Out of queries: remember the pass so EndPass() stays balanced, but do not time it.
+        current_->open_passes.push_back(current_->passes.size());
+        current_->passes.push_back({name, query_capacity_, query_capacity_});
+        return;
+    }
+    const auto query = current_->next_query;
+    current_->next_query += 2;
+    vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current_->query_pool, query);
+    current_->open_passes.push_back(current_->passes.size());
+    current_->passes.push_back({name, query, query + 1});
+}
+
+void GpuProfiler::EndPass(VkCommandBuffer command_buffer) {
+    SERENITY_DEBUG_LABEL_END(command_buffer);
+    if (current_ == nullptr || current_->open_passes.empty()) {
+        return;
+    }
+    const auto& pass = current_->passes[current_->open_passes.back()];
+    current_->open_passes.pop_back();
+    if (pass.end_query < query_capacity_) {
+        vkCmdWriteTimestamp(command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, current_->query_pool, pass.end_query);
+    }
+}
+
+std::vector<GpuPassStatistics> GpuProfiler::Statistics() const {
+    std::vector<GpuPassStatistics> statistics;
+    statistics.reserve(samples_.size());
+    for (const auto& [name, samples] : samples_) {
+        statistics.push_back({name, last_.at(name), samples.Min(), samples.Mean(), samples.Percentile(99.0), samples.Size()});
+    }
+    return statistics;
+}
+
+void GpuProfiler::Report() const {
+    for (const auto& pass : Statistics()) {
+        logger_->info("GPU pass {:<24} min {:>8.3f} ms, avg {:>8.3f} ms, p99 {:>8.3f} ms", pass.name, pass.min_ms, pass.avg_ms, pass.p99_ms);
+    }
+    if (dropped_results_ > 0) {
+        logger_->warn("GPU profiler dropped {} results that were not available in time", dropped_results_);
+    }
+}
+
+void GpuProfiler::CollectResults(Frame& frame) {
+    if (frame.next_query > 0) {
+        // Pairs of (timestamp, availability); VK_NOT_READY only means some pairs are unavailable.
+        std::vector<uint64_t> results(static_cast<size_t>(frame.next_query) * 2);
+        const auto result = vkGetQueryPoolResults(device_.Handle(), frame.query_pool, 0, frame.next_query, results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result == VK_SUCCESS || result == VK_NOT_READY) {
+#if defined(SERENITY_ENABLE_PROFILING)
+            // Without calibrated timestamps, line the frame's first GPU timestamp up with the time it was recorded.
+            const auto ticks_per_nanosecond = 1.0 / CpuProfiler::Get().NanosecondsPerTick();
+            const auto gpu_origin = results[0];
+            auto to_cpu_ticks = [&](uint64_t timestamp) {
+                return frame.cpu_ticks + static_cast<uint64_t>(static_cast<double>((timestamp - gpu_origin) & timestamp_mask_) * timestamp_period_ * ticks_per_nanosecond);
+            };
+#endif  // SERENITY_ENABLE_PROFILING
+            for (const auto& pass : frame.passes) {
+                if (pass.end_query >= frame.next_query) {
+                    continue;
+                }
+                if (results[pass.begin_query * 2 + 1] == 0 || results[pass.end_query * 2 + 1] == 0) {
+                    ++dropped_results_;
+                    continue;
+                }
+                const auto ticks = (results[pass.end_query * 2] - results[pass.begin_query * 2]) & timestamp_mask_;
+                const auto milliseconds = static_cast<double>(ticks) * timestamp_period_ / 1e6;
+                samples_.try_emplace(pass.name, SAMPLE_WINDOW_).first->second.Add(milliseconds);
+                last_[pass.name] = milliseconds;
+                FlightRecorder::Get().RecordGpuPass(pass.name, milliseconds);
+#if defined(SERENITY_ENABLE_PROFILING)
+                CpuProfiler::Get().RecordGpu(pass.name, to_cpu_ticks(results[pass.begin_query * 2]), to_cpu_ticks(results[pass.end_query * 2]));
+#endif  // SERENITY_ENABLE_PROFILING
+            }
+        }
+    }
+    frame.next_query = 0;
+    frame.passes.clear();
+    frame.open_passes.clear();
+}
+
+}  // namespace serenity
\ No newline at end of file
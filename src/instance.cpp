@@ -9,11 +9,18 @@
 #include <span>
 #include <string>
 
+#include "cpu_profiler.h"
+#include "debug_utils.h"
+
 namespace serenity {
 
 Instance::Instance(const std::shared_ptr<spdlog::logger>& logger) : logger_(logger) {
+    SERENITY_ZONE("Instance::Instance");
     CreateInstance();
     SetupDebugMessenger();
+#if !defined(NODEBUG)
+    DebugUtils::Load(instance_);
+#endif  // NODEBUG
 }
 
 Instance::~Instance() {
@@ -23,7 +30,31 @@ Instance::~Instance() {
     vkDestroyInstance(instance_, nullptr);
 }
 
+VkInstance Instance::Handle() const {
+    return instance_;
+}
+
+bool Instance::ValidationLayersEnabled() const {
+    return ENABLE_VALIDATION_LAYERS_;
+}
+
+const std::vector<const char*>& Instance::ValidationLayers() const {
+    return VALIDATION_LAYERS_;
+}
+
+uint64_t Instance::ValidationMessages(VkDebugUtilsMessageSeverityFlagBitsEXT severity) const {
+    switch (severity) {
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT:
+            return warning_messages_.load();
+        case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT:
+            return error_messages_.load();
+        default:
+            return info_messages_.load();
+    }
+}
+
 void Instance::CreateInstance() {
+    SERENITY_ZONE_FUNCTION();
     if (ENABLE_VALIDATION_LAYERS_ && !CheckValidationLayerSupport()) {
         throw std::runtime_error("Validation layers requested, but not available.");
     }
@@ -110,10 +141,11 @@ void Instance::PopulateDebugMessengerCreateInfo(VkDebugUtilsMessengerCreateInfoE
     create_info.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
     create_info.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
     create_info.pfnUserCallback = DebugCallback;
-    create_info.pUserData = &logger_;
+    create_info.pUserData = this;
 }
 
 void Instance::SetupDebugMessenger() {
+    SERENITY_ZONE_FUNCTION();
     if (!ENABLE_VALIDATION_LAYERS_) {
         return;
     }
@@ -132,7 +164,8 @@ void Instance::DestroyDebugUtilsMessengerEXT(VkInstance instance, VkDebugUtilsMe
 }
 
 VKAPI_ATTR VkBool32 VKAPI_CALL Instance::DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT message_severity, VkDebugUtilsMessageTypeFlagsEXT message_type, const VkDebugUtilsMessengerCallbackDataEXT* callback_data, void* user_data) {
-    auto* logger_ = static_cast<std::shared_ptr<spdlog::logger>*>(user_data);
+    auto* instance = static_cast<Instance*>(user_data);
+    auto& logger_ = instance->logger_;
     std::string type{};
     std::string message(callback_data->pMessage);
     if (!message.empty()) {
@@ -152,15 +185,18 @@ VKAPI_ATTR VkBool32 VKAPI_CALL Instance::DebugCallback(VkDebugUtilsMessageSeveri
         }
         switch (message_severity) {
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT: {
-                (*logger_)->warn("Validation layer({}): {}", type, message);
+                ++instance->warning_messages_;
+                logger_->warn("Validation layer({}): {}", type, message);
                 break;
             }
             case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT: {
-                (*logger_)->error("Validation layer({}): {}", type, message);
+                ++instance->error_messages_;
+                logger_->error("Validation layer({}): {}", type, message);
                 break;
             }
             default: {
-                (*logger_)->info("Validation layer({}): {}", type, message);
+                ++instance->info_messages_;
+                logger_->info("Validation layer({}): {}", type, message);
                 break;
             }
         }
@@ -0,0 +1,106 @@
+/**
+ * @file instance_batcher.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "instance_batcher.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+InstanceBatcher::InstanceBatcher(uint32_t threshold) : threshold_(std::max(threshold, 1U)) {
+}
+
+void InstanceBatcher::SetThreshold(uint32_t threshold) {
+    threshold_ = std::max(threshold, 1U);
+}
+
+uint32_t InstanceBatcher::Threshold() const {
+    return threshold_;
+}
+
+void InstanceBatcher::SetOrdered(uint32_t pass, bool ordered) {
+    if (pass >= ordered_.size()) {
+        throw std::runtime_error("Render pass " + std::to_string(pass) + " does not fit in a draw key.");
+    }
+    ordered_.set(pass, ordered);
+}
+
+bool InstanceBatcher::Ordered(uint32_t pass) const {
+    return pass < ordered_.size() && ordered_.test(pass);
+}
+
+const std::vector<BatchedDraw>& InstanceBatcher::Build(const RenderQueue& queue, const std::vector<DrawDesc>& draws, InstanceData* instances, size_t capacity) {
+    SERENITY_ZONE_FUNCTION();
+    const auto& items = queue.Items();
+    if (capacity < items.size()) {
+        throw std::runtime_error("Instance buffer holds " + std::to_string(capacity) + " instances, the render queue has " + std::to_string(items.size()) + " draws.");
+    }
+    commands_.clear();
+    stats_ = {};
+    stats_.draws = items.size();
+    uint32_t cursor = 0;
+    for (size_t begin = 0; begin < items.size();) {
+        // Draws with the same pass, pipeline and material are adjacent in a sorted queue; only depth tells them apart.
+        const auto state = items[begin].key >> DrawKey::DEPTH_BITS;
+        auto end = begin;
+        group_.clear();
+        for (; end < items.size() && items[end].key >> DrawKey::DEPTH_BITS == state; ++end) {
+            if (items[end].draw >= draws.size()) {
+                throw std::runtime_error("Render queue item refers to unknown draw " + std::to_string(items[end].draw) + ".");
+            }
+            group_.push_back(static_cast<uint32_t>(end));
+        }
+        // Gather each mesh's draws; the stable sort keeps them in depth order within the mesh. Ordered passes would
+        // draw meshes out of depth order that way, so they only merge the runs the queue already has.
+        if (!ordered_.test(DrawKey::Unpack(items[begin].key).pass)) {
+            std::stable_sort(group_.begin(), group_.end(), [&items, &draws](uint32_t a, uint32_t b) {
+                return draws[items[a].draw].mesh < draws[items[b].draw].mesh;
+            });
+        }
+        for (size_t first = 0; first < group_.size();) {
+            const auto mesh = draws[items[group_[first]].draw].mesh;
+            auto last = first;
+            while (last < group_.size() && draws[items[group_[last]].draw].mesh == mesh) {
+                ++last;
+            }
+            const auto count = static_cast<uint32_t>(last - first);
+            if (count >= threshold_) {
+                commands_.push_back({items[group_[first]].key, mesh, cursor, count});
+                ++stats_.instanced_commands;
+            }
+            for (auto i = first; i < last; ++i) {
+                if (count < threshold_) {
+                    commands_.push_back({items[group_[i]].key, mesh, cursor, 1});
+                }
+                instances[cursor++] = draws[items[group_[i]].draw].instance;
+            }
+            first = last;
+        }
+        begin = end;
+    }
+    stats_.commands = commands_.size();
+    stats_.draws_saved = stats_.draws - stats_.commands;
+    return commands_;
+}
+
+const std::vector<BatchedDraw>& InstanceBatcher::Draws() const {
+    return commands_;
+}
+
+const BatchStats& InstanceBatcher::Stats() const {
+    return stats_;
+}
+
+void InstanceBatcher::Clear() {
+    commands_.clear();
+    stats_ = {};
+}
+
+}  // namespace serenity
\ No newline at end of file
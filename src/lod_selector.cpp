@@ -0,0 +1,90 @@
+/**
+ * @file lod_selector.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "lod_selector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace serenity {
+
+namespace {
+
+// Bayer matrix, thresholds at the centre of each of the 16 steps.
+constexpr uint8_t BAYER_4X4[4][4] = {{0, 8, 2, 10}, {12, 4, 14, 6}, {3, 11, 1, 9}, {15, 7, 13, 5}};
+
+}  // namespace
+
+LodSelector::LodSelector(const LodSettings& settings) : settings_(settings) {
+}
+
+void LodSelector::SetSettings(const LodSettings& settings) {
+    settings_ = settings;
+}
+
+const LodSettings& LodSelector::Settings() const {
+    return settings_;
+}
+
+void LodSelector::SetView(const glm::vec3& camera, float fovy, float viewport_height) {
+    camera_ = camera;
+    pixels_per_unit_ = viewport_height / (2.0F * std::tan(fovy * 0.5F));
+}
+
+float LodSelector::ProjectedError(float error, const glm::vec3& center, float radius) const {
+    const auto distance = glm::distance(camera_, center) - radius;
+    if (distance <= 0.0F) {
+        return std::numeric_limits<float>::infinity();
+    }
+    return error * pixels_per_unit_ / distance;
+}
+
+LodSelection LodSelector::Select(const std::vector<LodLevel>& levels, const glm::vec3& center, float radius, float scale, LodState& state, float dt) const {
+    if (levels.empty()) {
+        throw std::runtime_error("LOD selection needs at least one level.");
+    }
+    // Errors grow with the level, so the first level over the limit ends the search.
+    auto coarsest_within = [&](float limit) {
+        uint32_t level = 0;
+        for (uint32_t i = 1; i < levels.size() && ProjectedError(levels[i].error * scale, center, radius) <= limit; ++i) {
+            level = i;
+        }
+        return level;
+    };
+    const auto last = static_cast<uint32_t>(levels.size() - 1);
+    auto target = std::min(state.level, last);
+    const auto refine = coarsest_within(settings_.pixel_error);
+    if (refine < target) {
+        // Too coarse for the budget: refine at once.
+        target = refine;
+    } else {
+        target = std::max(target, coarsest_within(settings_.pixel_error * (1.0F - settings_.hysteresis)));
+    }
+
+    if (state.previous != NO_LOD) {
+        state.fade = settings_.fade_time > 0.0F ? state.fade + dt / settings_.fade_time : 1.0F;
+        if (state.fade >= 1.0F) {
+            state.previous = NO_LOD;
+            state.fade = 1.0F;
+        }
+    }
+    if (target != state.level) {
+        // A switch during a fade drops the level that was fading out.
+        if (settings_.fade_time > 0.0F) {
+            state.previous = std::min(state.level, last);
+            state.fade = 0.0F;
+        }
+        state.level = target;
+    }
+    return {state.level, state.previous, state.fade};
+}
+
+bool LodSelector::DitherVisible(float fade, uint32_t x, uint32_t y) {
+    return (static_cast<float>(BAYER_4X4[y & 3][x & 3]) + 0.5F) / 16.0F < fade;
+}
+
+}  // namespace serenity
\ No newline at end of file
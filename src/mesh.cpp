@@ -0,0 +1,101 @@
+/**
+ * @file mesh.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "mesh.h"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "gtc/constants.hpp"
+
+namespace serenity {
+
+Aabb Mesh::Bounds() const {
+    Aabb box;
+    for (const auto& position : positions) {
+        box.Grow(position);
+    }
+    return box;
+}
+
+void Mesh::Validate() const {
+    if (normals.size() != positions.size()) {
+        throw std::runtime_error("Mesh needs one normal per position.");
+    }
+    if (!tangents.empty() && tangents.size() != positions.size()) {
+        throw std::runtime_error("Mesh tangents must be absent or one per position.");
+    }
+    if (!uvs.empty() && uvs.size() != positions.size()) {
+        throw std::runtime_error("Mesh UVs must be absent or one per position.");
+    }
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("Mesh indices must form whole triangles.");
+    }
+    for (auto index : indices) {
+        if (index >= positions.size()) {
+            throw std::runtime_error("Mesh index out of range.");
+        }
+    }
+}
+
+Mesh Mesh::Sphere(uint32_t rings, uint32_t segments, float radius) {
+    Mesh mesh;
+    for (uint32_t ring = 0; ring <= rings; ++ring) {
+        const auto v = static_cast<float>(ring) / static_cast<float>(rings);
+        const auto theta = v * glm::pi<float>();
+        for (uint32_t segment = 0; segment <= segments; ++segment) {
+            const auto u = static_cast<float>(segment) / static_cast<float>(segments);
+            const auto phi = u * glm::two_pi<float>();
+            const glm::vec3 normal(std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi));
+            mesh.positions.push_back(normal * radius);
+            mesh.normals.push_back(normal);
+            mesh.tangents.emplace_back(-std::sin(phi), 0.0F, std::cos(phi), 1.0F);
+            mesh.uvs.emplace_back(u, v);
+        }
+    }
+    const auto stride = segments + 1;
+    for (uint32_t ring = 0; ring < rings; ++ring) {
+        for (uint32_t segment = 0; segment < segments; ++segment) {
+            const auto a = ring * stride + segment;
+            const auto b = a + stride;
+            mesh.indices.insert(mesh.indices.end(), {a, a + 1, b, b, a + 1, b + 1});
+        }
+    }
+    return mesh;
+}
+
+Mesh Mesh::Terrain(uint32_t cells, float size, float height) {
+    Mesh mesh;
+    const auto step = size / static_cast<float>(cells);
+    auto elevation = [height, size](float x, float z) {
+        const auto k = glm::two_pi<float>() * 3.0F / size;
+        return height * std::sin(x * k) * std::cos(z * k * 0.7F);
+    };
+    for (uint32_t row = 0; row <= cells; ++row) {
+        for (uint32_t column = 0; column <= cells; ++column) {
+            const auto x = static_cast<float>(column) * step;
+            const auto z = static_cast<float>(row) * step;
+            mesh.positions.emplace_back(x, elevation(x, z), z);
+            // Central differences of the height field.
+            const auto dx = (elevation(x + step, z) - elevation(x - step, z)) / (2.0F * step);
+            const auto dz = (elevation(x, z + step) - elevation(x, z - step)) / (2.0F * step);
+            mesh.normals.push_back(glm::normalize(glm::vec3(-dx, 1.0F, -dz)));
+            mesh.tangents.emplace_back(glm::normalize(glm::vec3(1.0F, dx, 0.0F)), 1.0F);
+            mesh.uvs.emplace_back(x / size * 16.0F, z / size * 16.0F);
+        }
+    }
+    const auto stride = cells + 1;
+    for (uint32_t row = 0; row < cells; ++row) {
+        for (uint32_t column = 0; column < cells; ++column) {
+            const auto a = row * stride + column;
+            const auto b = a + stride;
+            mesh.indices.insert(mesh.indices.end(), {a, b, a + 1, a + 1, b, b + 1});
+        }
+    }
+    return mesh;
+}
+
+}  // namespace serenity
\ No newline at end of file
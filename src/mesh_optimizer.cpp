@@ -0,0 +1,365 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+namespace {
+
+constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+// The LRU cache Forsyth's scores model; larger than real hardware, which favours the nearest vertices anyway.
+constexpr uint32_t FORSYTH_CACHE_SIZE = 32;
+constexpr uint32_t VALENCE_TABLE_SIZE = 32;
+constexpr float LAST_TRIANGLE_SCORE = 0.75F;
+constexpr float CACHE_DECAY_POWER = 1.5F;
+constexpr float VALENCE_BOOST_SCALE = 2.0F;
+constexpr float VALENCE_BOOST_POWER = 0.5F;
+// Cache the overdraw pass assumes when finding cluster boundaries, matching AnalyzeVertexCache's default.
+constexpr uint32_t CLUSTER_CACHE_SIZE = 16;
+
+struct ForsythTables {
+    std::array<float, FORSYTH_CACHE_SIZE> cache{};
+    std::array<float, VALENCE_TABLE_SIZE> valence{};
+};
+
+const ForsythTables& Tables() {
+    static const ForsythTables tables = []() {
+        ForsythTables result;
+        for (uint32_t i = 0; i < FORSYTH_CACHE_SIZE; ++i) {
+            // The last triangle's vertices score the same whatever their order, so the next triangle is not biased
+            // towards one of its edges.
+            result.cache[i] = i < 3 ? LAST_TRIANGLE_SCORE : std::pow(1.0F - static_cast<float>(i - 3) / static_cast<float>(FORSYTH_CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+        for (uint32_t i = 1; i < VALENCE_TABLE_SIZE; ++i) {
+            result.valence[i] = VALENCE_BOOST_SCALE * std::pow(static_cast<float>(i), -VALENCE_BOOST_POWER);
+        }
+        return result;
+    }();
+    return tables;
+}
+
+// Vertices with few triangles left score high, so lone triangles get finished instead of stranded.
+float VertexScore(int32_t cache_position, uint32_t valence) {
+    if (valence == 0) {
+        return -1.0F;
+    }
+    const auto& tables = Tables();
+    const auto cached = cache_position < 0 ? 0.0F : tables.cache[cache_position];
+    const auto boost = valence < VALENCE_TABLE_SIZE ? tables.valence[valence] : VALENCE_BOOST_SCALE * std::pow(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+    return cached + boost;
+}
+
+// FIFO cache simulation: a vertex hits while fewer than cache_size other misses happened since it was loaded.
+class FifoCache {
+public:
+    FifoCache(size_t vertex_count, uint32_t cache_size) : cache_size_(cache_size), time_(cache_size + 1), loaded_(vertex_count, 0) {
+    }
+
+    bool Access(uint32_t vertex) {
+        if (time_ - loaded_[vertex] <= cache_size_) {
+            return true;
+        }
+        loaded_[vertex] = time_++;
+        return false;
+    }
+    void Flush() {
+        time_ += cache_size_ + 1;
+    }
+
+private:
+    uint32_t cache_size_;
+    uint32_t time_;
+    std::vector<uint32_t> loaded_;
+};
+
+void CheckIndices(const std::vector<uint32_t>& indices, size_t vertex_count) {
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("Index buffer must form whole triangles.");
+    }
+    for (auto index : indices) {
+        if (index >= vertex_count) {
+            throw std::runtime_error("Index buffer refers to a vertex out of range.");
+        }
+    }
+}
+
+template <typename T>
+void Remap(std::vector<T>& values, const std::vector<uint32_t>& remap, size_t count) {
+    if (values.empty()) {
+        return;
+    }
+    std::vector<T> result(count);
+    for (size_t i = 0; i < remap.size(); ++i) {
+        if (remap[i] != INVALID_INDEX) {
+            result[remap[i]] = values[i];
+        }
+    }
+    values = std::move(result);
+}
+
+}  // namespace
+
+VertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, size_t vertex_count, uint32_t cache_size) {
+    CheckIndices(indices, vertex_count);
+    VertexCacheStats stats;
+    stats.triangles = indices.size() / 3;
+    FifoCache cache(vertex_count, cache_size);
+    std::vector<uint8_t> referenced(vertex_count, 0);
+    for (auto index : indices) {
+        if (!cache.Access(index)) {
+            ++stats.transformed;
+        }
+        if (referenced[index] == 0) {
+            referenced[index] = 1;
+            ++stats.vertices;
+        }
+    }
+    return stats;
+}
+
+void OptimizeVertexCache(std::vector<uint32_t>& indices, size_t vertex_count) {
+    SERENITY_ZONE_FUNCTION();
+    CheckIndices(indices, vertex_count);
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0) {
+        return;
+    }
+    // Triangles using each vertex; the first live[v] entries of a vertex's range are the ones not yet emitted.
+    std::vector<uint32_t> live(vertex_count, 0);
+    for (auto index : indices) {
+        ++live[index];
+    }
+    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+    for (size_t v = 0; v < vertex_count; ++v) {
+        offsets[v + 1] = offsets[v] + live[v];
+    }
+    std::vector<uint32_t> adjacency(indices.size());
+    {
+        auto cursor = offsets;
+        for (size_t i = 0; i < indices.size(); ++i) {
+            adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+        }
+    }
+    std::vector<int32_t> cache_position(vertex_count, -1);
+    std::vector<float> vertex_score(vertex_count);
+    for (size_t v = 0; v < vertex_count; ++v) {
+        vertex_score[v] = VertexScore(-1, live[v]);
+    }
+    auto triangle_score = [&indices, &vertex_score](uint32_t triangle) {
+        return vertex_score[indices[triangle * 3]] + vertex_score[indices[triangle * 3 + 1]] + vertex_score[indices[triangle * 3 + 2]];
+    };
+
+    // Ties go to the lower triangle index everywhere, which keeps the output reproducible.
+    auto best = INVALID_INDEX;
+    auto best_score = -std::numeric_limits<float>::infinity();
+    for (uint32_t t = 0; t < triangle_count; ++t) {
+        const auto score = triangle_score(t);
+        if (score > best_score) {
+            best = t;
+            best_score = score;
+        }
+    }
+
+    std::vector<uint8_t> emitted(triangle_count, 0);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> next_cache;
+    size_t fallback = 0;
+    for (size_t count = 0; count < triangle_count; ++count) {
+        if (best == INVALID_INDEX) {
+            // Nothing in the cache has triangles left; continue with the next triangle in input order.
+            while (emitted[fallback] != 0) {
+                ++fallback;
+            }
+            best = static_cast<uint32_t>(fallback);
+        }
+        emitted[best] = 1;
+        next_cache.clear();
+        for (uint32_t k = 0; k < 3; ++k) {
+            const auto vertex = indices[best * 3 + k];
+            output.push_back(vertex);
+            const auto begin = adjacency.begin() + offsets[vertex];
+            const auto end = begin + live[vertex];
+            std::iter_swap(std::find(begin, end, best), end - 1);
+            --live[vertex];
+            if (std::find(next_cache.begin(), next_cache.end(), vertex) == next_cache.end()) {
+                next_cache.push_back(vertex);
+            }
+        }
+        const auto emitted_vertices = static_cast<std::ptrdiff_t>(next_cache.size());
+        for (auto vertex : cache) {
+            if (std::find(next_cache.begin(), next_cache.begin() + emitted_vertices, vertex) == next_cache.begin() + emitted_vertices) {
+                next_cache.push_back(vertex);
+            }
+        }
+        // Vertices pushed past the end of the cache are evicted; rescore them along with the ones that moved.
+        for (size_t i = 0; i < next_cache.size(); ++i) {
+            const auto vertex = next_cache[i];
+            cache_position[vertex] = i < FORSYTH_CACHE_SIZE ? static_cast<int32_t>(i) : -1;
+            vertex_score[vertex] = VertexScore(cache_position[vertex], live[vertex]);
+        }
+        next_cache.resize(std::min<size_t>(next_cache.size(), FORSYTH_CACHE_SIZE));
+        std::swap(cache, next_cache);
+
+        best = INVALID_INDEX;
+        best_score = -std::numeric_limits<float>::infinity();
+        for (auto vertex : cache) {
+            for (uint32_t i = 0; i < live[vertex]; ++i) {
+                const auto triangle = adjacency[offsets[vertex] + i];
+                const auto score = triangle_score(triangle);
+                if (score > best_score || (score == best_score && triangle < best)) {
+                    best = triangle;
+                    best_score = score;
+                }
+            }
+        }
+    }
+    indices = std::move(output);
+}
+
+size_t OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<glm::vec3>& positions, float threshold) {
+    SERENITY_ZONE_FUNCTION();
+    CheckIndices(indices, positions.size());
+    const auto triangle_count = indices.size() / 3;
+    if (triangle_count == 0) {
+        return 0;
+    }
+    // Hard boundaries: triangles that miss on all three vertices, where the cache has effectively started over.
+    std::vector<uint32_t> hard;
+    {
+        FifoCache cache(positions.size(), CLUSTER_CACHE_SIZE);
+        for (uint32_t t = 0; t < triangle_count; ++t) {
+            uint32_t misses = 0;
+            for (uint32_t k = 0; k < 3; ++k) {
+                misses += cache.Access(indices[t * 3 + k]) ? 0 : 1;
+            }
+            if (t == 0 || misses == 3) {
+                hard.push_back(t);
+            }
+        }
+        hard.push_back(static_cast<uint32_t>(triangle_count));
+    }
+    // Soft boundaries split a hard cluster once the part so far, drawn from a cold cache, is within the threshold
+    // of the whole buffer's ACMR, so reordering clusters costs at most that much cache efficiency.
+    const auto limit = AnalyzeVertexCache(indices, positions.size(), CLUSTER_CACHE_SIZE).Acmr() * threshold;
+    std::vector<uint32_t> starts;
+    {
+        FifoCache cache(positions.size(), CLUSTER_CACHE_SIZE);
+        for (size_t h = 0; h + 1 < hard.size(); ++h) {
+            cache.Flush();
+            starts.push_back(hard[h]);
+            uint32_t misses = 0;
+            uint32_t size = 0;
+            for (auto t = hard[h]; t < hard[h + 1]; ++t) {
+                if (size > 0 && static_cast<float>(misses) <= limit * static_cast<float>(size)) {
+                    cache.Flush();
+                    starts.push_back(t);
+                    misses = 0;
+                    size = 0;
+                }
+                for (uint32_t k = 0; k < 3; ++k) {
+                    misses += cache.Access(indices[t * 3 + k]) ? 0 : 1;
+                }
+                ++size;
+            }
+        }
+        starts.push_back(static_cast<uint32_t>(triangle_count));
+    }
+
+    const auto cluster_count = starts.size() - 1;
+    std::vector<glm::vec3> centroids(cluster_count, glm::vec3(0.0F));
+    std::vector<glm::vec3> normals(cluster_count, glm::vec3(0.0F));
+    glm::vec3 mesh_centroid(0.0F);
+    float mesh_area = 0.0F;
+    for (size_t c = 0; c < cluster_count; ++c) {
+        glm::vec3 weighted(0.0F);
+        glm::vec3 plain(0.0F);
+        float area = 0.0F;
+        for (auto t = starts[c]; t < starts[c + 1]; ++t) {
+            const auto& p0 = positions[indices[t * 3]];
+            const auto& p1 = positions[indices[t * 3 + 1]];
+            const auto& p2 = positions[indices[t * 3 + 2]];
+            const auto normal = glm::cross(p1 - p0, p2 - p0);
+            const auto triangle_area = glm::length(normal);
+            const auto center = (p0 + p1 + p2) / 3.0F;
+            weighted += center * triangle_area;
+            plain += center;
+            area += triangle_area;
+            normals[c] += normal;
+        }
+        centroids[c] = area > 0.0F ? weighted / area : plain / static_cast<float>(starts[c + 1] - starts[c]);
+        mesh_centroid += weighted;
+        mesh_area += area;
+    }
+    if (mesh_area > 0.0F) {
+        mesh_centroid /= mesh_area;
+    }
+    std::vector<float> sort_keys(cluster_count, 0.0F);
+    for (size_t c = 0; c < cluster_count; ++c) {
+        const auto length = glm::length(normals[c]);
+        if (length > 0.0F) {
+            sort_keys[c] = glm::dot(centroids[c] - mesh_centroid, normals[c] / length);
+        }
+    }
+    std::vector<uint32_t> order(cluster_count);
+    for (size_t c = 0; c < cluster_count; ++c) {
+        order[c] = static_cast<uint32_t>(c);
+    }
+    std::stable_sort(order.begin(), order.end(), [&sort_keys](uint32_t a, uint32_t b) {
+        return sort_keys[a] > sort_keys[b];
+    });
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (auto c : order) {
+        output.insert(output.end(), indices.begin() + starts[c] * 3, indices.begin() + starts[c + 1] * 3);
+    }
+    indices = std::move(output);
+    return cluster_count;
+}
+
+size_t OptimizeVertexFetch(Mesh& mesh) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    std::vector<uint32_t> remap(mesh.VertexCount(), INVALID_INDEX);
+    uint32_t next = 0;
+    for (auto& index : mesh.indices) {
+        if (remap[index] == INVALID_INDEX) {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+    Remap(mesh.positions, remap, next);
+    Remap(mesh.normals, remap, next);
+    Remap(mesh.tangents, remap, next);
+    Remap(mesh.uvs, remap, next);
+    return next;
+}
+
+MeshOptimizationReport OptimizeMesh(Mesh& mesh, float overdraw_threshold) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    MeshOptimizationReport report;
+    const auto vertex_count = mesh.VertexCount();
+    report.before = AnalyzeVertexCache(mesh.indices, vertex_count);
+    OptimizeVertexCache(mesh.indices, vertex_count);
+    report.clusters = OptimizeOverdraw(mesh.indices, mesh.positions, overdraw_threshold);
+    report.vertices_removed = vertex_count - OptimizeVertexFetch(mesh);
+    report.after = AnalyzeVertexCache(mesh.indices, mesh.VertexCount());
+    return report;
+}
+
+}  // namespace serenity
\ No newline at end of file
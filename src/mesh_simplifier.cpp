@@ -0,0 +1,312 @@
+/**
+ * @file mesh_simplifier.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+
+#include "cpu_profiler.h"
+#include "mesh_optimizer.h"
+
+namespace serenity {
+
+namespace {
+
+// A level keeping more than this fraction of the previous level's indices is not worth its memory.
+constexpr float MIN_LEVEL_SHRINK = 0.9F;
+
+// Sum of squared distances to a set of planes, weighted by triangle area, in double precision so long collapse
+// chains do not drift.
+struct Quadric {
+    double a00{0.0}, a01{0.0}, a02{0.0}, a11{0.0}, a12{0.0}, a22{0.0};
+    double b0{0.0}, b1{0.0}, b2{0.0};
+    double c{0.0};
+    double weight{0.0};
+
+    static Quadric FromPlane(const glm::dvec3& normal, double distance, double weight) {
+        Quadric q;
+        q.a00 = weight * normal.x * normal.x;
+        q.a01 = weight * normal.x * normal.y;
+        q.a02 = weight * normal.x * normal.z;
+        q.a11 = weight * normal.y * normal.y;
+        q.a12 = weight * normal.y * normal.z;
+        q.a22 = weight * normal.z * normal.z;
+        q.b0 = weight * distance * normal.x;
+        q.b1 = weight * distance * normal.y;
+        q.b2 = weight * distance * normal.z;
+        q.c = weight * distance * distance;
+        q.weight = weight;
+        return q;
+    }
+    Quadric& operator+=(const Quadric& q) {
+        a00 += q.a00;
+        a01 += q.a01;
+        a02 += q.a02;
+        a11 += q.a11;
+        a12 += q.a12;
+        a22 += q.a22;
+        b0 += q.b0;
+        b1 += q.b1;
+        b2 += q.b2;
+        c += q.c;
+        weight += q.weight;
+        return *this;
+    }
+    // Weighted mean squared distance of p to the planes.
+    double Evaluate(const glm::vec3& point) const {
+        if (weight <= 0.0) {
+            return 0.0;
+        }
+        const glm::dvec3 p(point);
+        const auto quadratic = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z + 2.0 * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z);
+        const auto linear = 2.0 * (b0 * p.x + b1 * p.y + b2 * p.z);
+        return std::max(0.0, (quadratic + linear + c) / weight);
+    }
+};
+
+struct Collapse {
+    uint32_t from{0};
+    uint32_t to{0};
+    float error{0.0F};
+};
+
+class Simplifier {
+public:
+    explicit Simplifier(const Mesh& mesh) : mesh_(mesh), indices_(mesh.indices) {
+        const auto vertex_count = mesh.VertexCount();
+        // Vertices sharing a position form one group, represented by the lowest index among them.
+        std::vector<uint32_t> order(vertex_count);
+        std::iota(order.begin(), order.end(), 0U);
+        auto position_less = [&mesh](uint32_t a, uint32_t b) {
+            const auto& pa = mesh.positions[a];
+            const auto& pb = mesh.positions[b];
+            return std::tie(pa.x, pa.y, pa.z, a) < std::tie(pb.x, pb.y, pb.z, b);
+        };
+        std::sort(order.begin(), order.end(), position_less);
+        group_.resize(vertex_count);
+        locked_.assign(vertex_count, 0);
+        for (size_t i = 0; i < vertex_count;) {
+            auto end = i + 1;
+            while (end < vertex_count && mesh.positions[order[end]] == mesh.positions[order[i]]) {
+                ++end;
+            }
+            for (auto j = i; j < end; ++j) {
+                group_[order[j]] = order[i];
+            }
+            // Several vertices at one position mark an attribute seam.
+            locked_[order[i]] = end - i > 1 ? 1 : 0;
+            i = end;
+        }
+        // Edges used by one triangle lie on an open border, more than two on a non-manifold fan; lock both.
+        std::vector<std::pair<uint32_t, uint32_t>> edges;
+        edges.reserve(indices_.size());
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            for (size_t k = 0; k < 3; ++k) {
+                const auto a = group_[indices_[t + k]];
+                const auto b = group_[indices_[t + (k + 1) % 3]];
+                if (a != b) {
+                    edges.emplace_back(std::min(a, b), std::max(a, b));
+                }
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+        for (size_t i = 0; i < edges.size();) {
+            auto end = i + 1;
+            while (end < edges.size() && edges[end] == edges[i]) {
+                ++end;
+            }
+            if (end - i != 2) {
+                locked_[edges[i].first] = 1;
+                locked_[edges[i].second] = 1;
+            }
+            i = end;
+        }
+        quadrics_.resize(vertex_count);
+        for (size_t t = 0; t < indices_.size(); t += 3) {
+            const glm::dvec3 p0(mesh.positions[indices_[t]]);
+            const glm::dvec3 p1(mesh.positions[indices_[t + 1]]);
+            const glm::dvec3 p2(mesh.positions[indices_[t + 2]]);
+            const auto normal = glm::cross(p1 - p0, p2 - p0);
+            const auto area = glm::length(normal);
+            if (area == 0.0) {
+                continue;
+            }
+            const auto unit = normal / area;
+            const auto quadric = Quadric::FromPlane(unit, -glm::dot(unit, p0), area);
+            for (size_t k = 0; k < 3; ++k) {
+                quadrics_[group_[indices_[t + k]]] += quadric;
+            }
+        }
+    }
+
+    // Collapses in passes of independent edges, cheapest first, until the target or the error limit is reached.
+    void Run(size_t target_index_count, float max_error) {
+        const auto vertex_count = mesh_.VertexCount();
+        std::vector<uint32_t> offsets(vertex_count + 1);
+        std::vector<uint32_t> adjacency;
+        std::vector<Collapse> collapses;
+        std::vector<uint8_t> touched(vertex_count);
+        std::vector<uint32_t> remap(vertex_count);
+        while (indices_.size() > target_index_count) {
+            // Triangles around each vertex.
+            std::fill(offsets.begin(), offsets.end(), 0U);
+            for (auto index : indices_) {
+                ++offsets[index + 1];
+            }
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+            adjacency.resize(indices_.size());
+            {
+                auto cursor = offsets;
+                for (size_t i = 0; i < indices_.size(); ++i) {
+                    adjacency[cursor[indices_[i]]++] = static_cast<uint32_t>(i / 3);
+                }
+            }
+            collapses.clear();
+            for (size_t t = 0; t < indices_.size(); t += 3) {
+                for (size_t k = 0; k < 3; ++k) {
+                    const auto a = indices_[t + k];
+                    const auto b = indices_[t + (k + 1) % 3];
+                    if (locked_[group_[a]] == 0) {
+                        collapses.push_back({a, b, Cost(a, b)});
+                    }
+                    if (locked_[group_[b]] == 0) {
+                        collapses.push_back({b, a, Cost(b, a)});
+                    }
+                }
+            }
+            std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) {
+                return std::tie(a.error, a.from, a.to) < std::tie(b.error, b.from, b.to);
+            });
+
+            std::fill(touched.begin(), touched.end(), uint8_t{0});
+            std::iota(remap.begin(), remap.end(), 0U);
+            const auto triangles_needed = (indices_.size() - target_index_count + 2) / 3;
+            size_t triangles_removed = 0;
+            size_t performed = 0;
+            for (const auto& collapse : collapses) {
+                if (collapse.error > max_error || triangles_removed >= triangles_needed) {
+                    break;
+                }
+                // Duplicates of an edge sort next to each other; the first one marks both ends touched.
+                if (touched[group_[collapse.from]] != 0 || touched[group_[collapse.to]] != 0 || !Valid(collapse, offsets, adjacency)) {
+                    continue;
+                }
+                // Nothing around a collapsed vertex may move again this pass, so the flip test above stays exact.
+                for (auto i = offsets[collapse.from]; i < offsets[collapse.from + 1]; ++i) {
+                    const auto t = adjacency[i] * 3;
+                    const auto collapsing = indices_[t] == collapse.to || indices_[t + 1] == collapse.to || indices_[t + 2] == collapse.to;
+                    triangles_removed += collapsing ? 1 : 0;
+                    for (size_t k = 0; k < 3; ++k) {
+                        touched[group_[indices_[t + k]]] = 1;
+                    }
+                }
+                remap[collapse.from] = collapse.to;
+                quadrics_[group_[collapse.to]] += quadrics_[group_[collapse.from]];
+                error_ = std::max(error_, collapse.error);
+                ++performed;
+            }
+            if (performed == 0) {
+                break;
+            }
+            size_t kept = 0;
+            for (size_t t = 0; t < indices_.size(); t += 3) {
+                const auto a = remap[indices_[t]];
+                const auto b = remap[indices_[t + 1]];
+                const auto c = remap[indices_[t + 2]];
+                if (a != b && b != c && c != a) {
+                    indices_[kept++] = a;
+                    indices_[kept++] = b;
+                    indices_[kept++] = c;
+                }
+            }
+            indices_.resize(kept);
+        }
+    }
+
+    const std::vector<uint32_t>& Indices() const {
+        return indices_;
+    }
+    float Error() const {
+        return error_;
+    }
+
+private:
+    float Cost(uint32_t from, uint32_t to) const {
+        auto quadric = quadrics_[group_[from]];
+        quadric += quadrics_[group_[to]];
+        return static_cast<float>(std::sqrt(quadric.Evaluate(mesh_.positions[to])));
+    }
+
+    // Rejects collapses that would turn a surviving triangle over or flatten it to nothing.
+    bool Valid(const Collapse& collapse, const std::vector<uint32_t>& offsets, const std::vector<uint32_t>& adjacency) const {
+        const auto& target = mesh_.positions[collapse.to];
+        for (auto i = offsets[collapse.from]; i < offsets[collapse.from + 1]; ++i) {
+            const auto t = adjacency[i] * 3;
+            if (indices_[t] == collapse.to || indices_[t + 1] == collapse.to || indices_[t + 2] == collapse.to) {
+                continue;
+            }
+            glm::vec3 before[3];
+            glm::vec3 after[3];
+            for (size_t k = 0; k < 3; ++k) {
+                before[k] = mesh_.positions[indices_[t + k]];
+                after[k] = indices_[t + k] == collapse.from ? target : before[k];
+            }
+            const auto normal_before = glm::cross(before[1] - before[0], before[2] - before[0]);
+            const auto normal_after = glm::cross(after[1] - after[0], after[2] - after[0]);
+            if (glm::dot(normal_before, normal_after) <= 0.0F) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    const Mesh& mesh_;
+    std::vector<uint32_t> indices_;
+    std::vector<uint32_t> group_{};
+    std::vector<uint8_t> locked_{};
+    std::vector<Quadric> quadrics_{};
+    float error_{0.0F};
+};
+
+}  // namespace
+
+SimplifyResult Simplify(const Mesh& mesh, size_t target_index_count, float max_error) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    Simplifier simplifier(mesh);
+    simplifier.Run(target_index_count, max_error);
+    return {simplifier.Indices(), simplifier.Error()};
+}
+
+LodChain GenerateLods(const Mesh& mesh, const LodOptions& options) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    LodChain chain;
+    chain.mesh = mesh;
+    chain.levels.push_back({0, static_cast<uint32_t>(mesh.indices.size()), 0.0F});
+    Simplifier simplifier(mesh);
+    const auto min_indices = static_cast<size_t>(options.min_triangles) * 3;
+    auto current = mesh.indices.size();
+    while (chain.levels.size() < options.max_levels && current > min_indices) {
+        const auto target = std::max(static_cast<size_t>(static_cast<float>(current / 3) * options.reduction) * 3, min_indices);
+        simplifier.Run(target, options.max_error);
+        const auto& simplified = simplifier.Indices();
+        if (static_cast<float>(simplified.size()) > static_cast<float>(current) * MIN_LEVEL_SHRINK) {
+            break;
+        }
+        auto indices = simplified;
+        OptimizeVertexCache(indices, mesh.VertexCount());
+        chain.levels.push_back({static_cast<uint32_t>(chain.mesh.indices.size()), static_cast<uint32_t>(indices.size()), simplifier.Error()});
+        chain.mesh.indices.insert(chain.mesh.indices.end(), indices.begin(), indices.end());
+        current = indices.size();
+    }
+    return chain;
+}
+
+}  // namespace serenity
\ No newline at end of file
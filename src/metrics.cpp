@@ -0,0 +1,189 @@
+/**
+ * @file metrics.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include "spdlog/fmt/fmt.h"
+
+namespace serenity {
+
+namespace {
+
+std::string Escape(const std::string& value, bool label) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (auto c : value) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else if (c == '"' && label) {
+            escaped += "\\\"";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string FormatLabels(const MetricLabels& labels, const std::string& extra_name = {}, const std::string& extra_value = {}) {
+    if (labels.empty() && extra_name.empty()) {
+        return {};
+    }
+    std::string text = "{";
+    for (const auto& [name, value] : labels) {
+        text += (text.size() > 1 ? "," : "") + name + "=\"" + Escape(value, true) + "\"";
+    }
+    if (!extra_name.empty()) {
+        text += (text.size() > 1 ? "," : "") + extra_name + "=\"" + extra_value + "\"";
+    }
+    return text + "}";
+}
+
+std::string FormatValue(double value) {
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "+Inf" : "-Inf";
+    }
+    return fmt::format("{}", value);
+}
+
+}  // namespace
+
+void Counter::Increment(uint64_t amount) {
+    value_.fetch_add(amount, std::memory_order_relaxed);
+}
+
+uint64_t Counter::Value() const {
+    return value_.load(std::memory_order_relaxed);
+}
+
+void Gauge::Set(double value) {
+    value_.store(value, std::memory_order_relaxed);
+}
+
+double Gauge::Value() const {
+    return value_.load(std::memory_order_relaxed);
+}
+
+Histogram::Histogram(std::vector<double> bounds) : bounds_(std::move(bounds)), counts_(std::make_unique<std::atomic<uint64_t>[]>(bounds_.size() + 1)) {
+    if (!std::is_sorted(bounds_.begin(), bounds_.end())) {
+        throw std::runtime_error("Histogram bucket bounds must be sorted.");
+    }
+}
+
+void Histogram::Observe(double value) {
+    // The last slot is the implicit +Inf bucket.
+    const auto bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    counts_[static_cast<size_t>(bucket)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+const std::vector<double>& Histogram::Bounds() const {
+    return bounds_;
+}
+
+std::vector<uint64_t> Histogram::CumulativeCounts() const {
+    std::vector<uint64_t> counts(bounds_.size() + 1);
+    uint64_t total = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        total += counts_[i].load(std::memory_order_relaxed);
+        counts[i] = total;
+    }
+    return counts;
+}
+
+double Histogram::Sum() const {
+    return sum_.load(std::memory_order_relaxed);
+}
+
+Counter& MetricsRegistry::AddCounter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = FindOrAdd(name, help, Type::COUNTER, labels);
+    if (!series.counter) {
+        series.counter = std::make_unique<Counter>();
+    }
+    return *series.counter;
+}
+
+Gauge& MetricsRegistry::AddGauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = FindOrAdd(name, help, Type::GAUGE, labels);
+    if (!series.gauge) {
+        series.gauge = std::make_unique<Gauge>();
+    }
+    return *series.gauge;
+}
+
+Histogram& MetricsRegistry::AddHistogram(const std::string& name, const std::string& help, const std::vector<double>& bounds, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& series = FindOrAdd(name, help, Type::HISTOGRAM, labels);
+    if (!series.histogram) {
+        series.histogram = std::make_unique<Histogram>(bounds);
+    }
+    return *series.histogram;
+}
+
+void MetricsRegistry::AddCounterCallback(const std::string& name, const std::string& help, const MetricLabels& labels, Sampler sampler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FindOrAdd(name, help, Type::COUNTER, labels).sampler = std::move(sampler);
+}
+
+void MetricsRegistry::AddGaugeCallback(const std::string& name, const std::string& help, const MetricLabels& labels, Sampler sampler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    FindOrAdd(name, help, Type::GAUGE, labels).sampler = std::move(sampler);
+}
+
+std::string MetricsRegistry::Render() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::string text;
+    for (const auto& [name, family] : families_) {
+        text += "# HELP " + name + " " + Escape(family.help, false) + "\n";
+        const auto* type = family.type == Type::COUNTER ? "counter" : (family.type == Type::HISTOGRAM ? "histogram" : "gauge");
+        text += "# TYPE " + name + " " + type + "\n";
+        for (const auto& series : family.series) {
+            if (series->histogram) {
+                const auto& bounds = series->histogram->Bounds();
+                const auto counts = series->histogram->CumulativeCounts();
+                for (size_t i = 0; i < counts.size(); ++i) {
+                    const auto bound = i < bounds.size() ? FormatValue(bounds[i]) : "+Inf";
+                    text += name + "_bucket" + FormatLabels(series->labels, "le", bound) + " " + std::to_string(counts[i]) + "\n";
+                }
+                text += name + "_sum" + FormatLabels(series->labels) + " " + FormatValue(series->histogram->Sum()) + "\n";
+                text += name + "_count" + FormatLabels(series->labels) + " " + std::to_string(counts.back()) + "\n";
+            } else if (series->sampler) {
+                text += name + FormatLabels(series->labels) + " " + FormatValue(series->sampler()) + "\n";
+            } else if (series->counter) {
+                text += name + FormatLabels(series->labels) + " " + std::to_string(series->counter->Value()) + "\n";
+            } else if (series->gauge) {
+                text += name + FormatLabels(series->labels) + " " + FormatValue(series->gauge->Value()) + "\n";
+            }
+        }
+    }
+    return text;
+}
+
+MetricsRegistry::Series& MetricsRegistry::FindOrAdd(const std::string& name, const std::string& help, Type type, const MetricLabels& labels) {
+    auto& family = families_.try_emplace(name, Family{type, help}).first->second;
+    if (family.type != type) {
+        throw std::runtime_error("Metric " + name + " is already registered with another type.");
+    }
+    for (auto& series : family.series) {
+        if (series->labels == labels) {
+            return *series;
+        }
+    }
+    family.series.push_back(std::make_unique<Series>(Series{labels}));
+    return *family.series.back();
+}
+
+}  // namespace serenity
\ No newline at end of file
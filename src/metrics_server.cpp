@@ -0,0 +1,160 @@
+/**
+ * @file metrics_server.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "metrics_server.h"
+
+#include <stdexcept>
+#include <string>
+
+#if defined(_WIN32)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+namespace {
+
+#if defined(_WIN32)
+using NativeSocket = SOCKET;
+const auto INVALID = static_cast<std::uintptr_t>(INVALID_SOCKET);
+
+void CloseSocket(std::uintptr_t socket) {
+    closesocket(static_cast<NativeSocket>(socket));
+}
+#else
+using NativeSocket = int;
+const auto INVALID = static_cast<std::uintptr_t>(-1);
+
+void CloseSocket(std::uintptr_t socket) {
+    close(static_cast<NativeSocket>(socket));
+}
+#endif
+
+// A scraper hanging up mid-response must not raise SIGPIPE and kill the process. Linux takes a per-call flag; macOS
+// has no MSG_NOSIGNAL and uses SO_NOSIGPIPE on the socket instead, see Respond().
+#if defined(MSG_NOSIGNAL)
+constexpr int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr int SEND_FLAGS = 0;
+#endif
+
+constexpr size_t MAX_REQUEST = 4096;
+constexpr long POLL_MICROSECONDS = 200000;
+
+void SendAll(std::uintptr_t socket, const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        const auto result = send(static_cast<NativeSocket>(socket), data.data() + sent, static_cast<int>(data.size() - sent), SEND_FLAGS);
+        if (result <= 0) {
+            return;
+        }
+        sent += static_cast<size_t>(result);
+    }
+}
+
+}  // namespace
+
+MetricsServer::MetricsServer(const MetricsRegistry& registry, uint16_t port, const std::shared_ptr<spdlog::logger>& logger) : registry_(registry), logger_(logger) {
+#if defined(_WIN32)
+    WSADATA data;
+    if (WSAStartup(MAKEWORD(2, 2), &data) != 0) {
+        throw std::runtime_error("Failed to initialize Winsock.");
+    }
+#endif
+    listener_ = static_cast<std::uintptr_t>(socket(AF_INET, SOCK_STREAM, IPPROTO_TCP));
+    if (listener_ == INVALID) {
+        throw std::runtime_error("Failed to create metrics socket.");
+    }
+    int reuse = 1;
+    setsockopt(static_cast<NativeSocket>(listener_), SOL_SOCKET, SO_REUSEADDR, reinterpret_cast<const char*>(&reuse), sizeof(reuse));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (bind(static_cast<NativeSocket>(listener_), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(static_cast<NativeSocket>(listener_), 4) != 0) {
+        CloseSocket(listener_);
+        throw std::runtime_error("Failed to listen for metrics on 127.0.0.1:" + std::to_string(port) + ".");
+    }
+    thread_ = std::thread(&MetricsServer::Serve, this);
+    logger_->info("Serving metrics on http://127.0.0.1:{}/metrics", port);
+}
+
+MetricsServer::~MetricsServer() {
+    running_ = false;
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    CloseSocket(listener_);
+#if defined(_WIN32)
+    WSACleanup();
+#endif
+}
+
+void MetricsServer::Serve() {
+    SERENITY_ZONE_THREAD_NAME("metrics");
+    // Wake up regularly so the destructor never waits on a blocking accept.
+    while (running_) {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(static_cast<NativeSocket>(listener_), &readable);
+        timeval timeout{0, POLL_MICROSECONDS};
+        if (select(static_cast<int>(listener_ + 1), &readable, nullptr, nullptr, &timeout) <= 0) {
+            continue;
+        }
+        const auto client = static_cast<std::uintptr_t>(accept(static_cast<NativeSocket>(listener_), nullptr, nullptr));
+        if (client == INVALID) {
+            continue;
+        }
+        Respond(client);
+        CloseSocket(client);
+    }
+}
+
+void MetricsServer::Respond(std::uintptr_t client) {
+    SERENITY_ZONE_FUNCTION();
+#if defined(_WIN32)
+    DWORD timeout = 1000;
+#else
+    timeval timeout{1, 0};
+#endif
+    // A scraper that stops reading must not block send() and, through it, the destructor's join().
+    setsockopt(static_cast<NativeSocket>(client), SOL_SOCKET, SO_RCVTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+    setsockopt(static_cast<NativeSocket>(client), SOL_SOCKET, SO_SNDTIMEO, reinterpret_cast<const char*>(&timeout), sizeof(timeout));
+#if defined(SO_NOSIGPIPE)
+    int no_sigpipe = 1;
+    setsockopt(static_cast<NativeSocket>(client), SOL_SOCKET, SO_NOSIGPIPE, &no_sigpipe, sizeof(no_sigpipe));
+#endif
+    std::string request;
+    char buffer[512];
+    while (request.find("\r\n\r\n") == std::string::npos && request.size() < MAX_REQUEST) {
+        const auto received = recv(static_cast<NativeSocket>(client), buffer, sizeof(buffer), 0);
+        if (received <= 0) {
+            break;
+        }
+        request.append(buffer, static_cast<size_t>(received));
+    }
+    std::string status = "200 OK";
+    std::string body;
+    if (request.rfind("GET /metrics ", 0) == 0 || request.rfind("GET / ", 0) == 0) {
+        body = registry_.Render();
+    } else if (request.rfind("GET ", 0) == 0) {
+        status = "404 Not Found";
+    } else {
+        status = "405 Method Not Allowed";
+    }
+    SendAll(client, "HTTP/1.1 " + status + "\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\nContent-Length: " + std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body);
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file pipeline_statistics.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "pipeline_statistics.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "debug_utils.h"
+
+namespace serenity {
+
+namespace {
+
+// Results come back in bit order of the enabled flags, which is the order of the PipelineCounters fields.
+constexpr VkQueryPipelineStatisticFlags STATISTICS_FLAGS = VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT | VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT | VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+
+double Ratio(uint64_t numerator, uint64_t denominator) {
+    return denominator == 0 ? 0.0 : static_cast<double>(numerator) / static_cast<double>(denominator);
+}
+
+}  // namespace
+
+PipelineCounters& PipelineCounters::operator+=(const PipelineCounters& counters) {
+    input_vertices += counters.input_vertices;
+    input_primitives += counters.input_primitives;
+    vertex_invocations += counters.vertex_invocations;
+    clipping_invocations += counters.clipping_invocations;
+    clipping_primitives += counters.clipping_primitives;
+    fragment_invocations += counters.fragment_invocations;
+    compute_invocations += counters.compute_invocations;
+    samples_passed += counters.samples_passed;
+    return *this;
+}
+
+PipelineStatistics::PipelineStatistics(const Device& device, uint32_t frames_in_flight, uint32_t max_passes, const std::shared_ptr<spdlog::logger>& logger) : device_(device), max_passes_(max_passes), logger_(logger) {
+    if (device_.Features().pipelineStatisticsQuery != VK_TRUE) {
+        logger_->warn("Device does not support pipeline statistics queries, pipeline statistics disabled");
+        return;
+    }
+    occlusion_flags_ = device_.Features().occlusionQueryPrecise == VK_TRUE ? VK_QUERY_CONTROL_PRECISE_BIT : 0;
+
+    VkQueryPoolCreateInfo statistics_info{};
+    statistics_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    statistics_info.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+    statistics_info.queryCount = max_passes_;
+    statistics_info.pipelineStatistics = STATISTICS_FLAGS;
+    VkQueryPoolCreateInfo occlusion_info{};
+    occlusion_info.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    occlusion_info.queryType = VK_QUERY_TYPE_OCCLUSION;
+    occlusion_info.queryCount = max_passes_;
+    frames_.resize(frames_in_flight);
+    for (size_t i = 0; i < frames_.size(); ++i) {
+        auto& frame = frames_[i];
+        if (vkCreateQueryPool(device_.Handle(), &statistics_info, nullptr, &frame.statistics_pool) != VK_SUCCESS || vkCreateQueryPool(device_.Handle(), &occlusion_info, nullptr, &frame.occlusion_pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create pipeline statistics query pools.");
+        }
+        SERENITY_DEBUG_NAME(device_.Handle(), VK_OBJECT_TYPE_QUERY_POOL, frame.statistics_pool, "Pipeline statistics " + std::to_string(i));
+        SERENITY_DEBUG_NAME(device_.Handle(), VK_OBJECT_TYPE_QUERY_POOL, frame.occlusion_pool, "Occlusion " + std::to_string(i));
+    }
+    enabled_ = true;
+}
+
+PipelineStatistics::~PipelineStatistics() {
+    for (auto& frame : frames_) {
+        if (frame.statistics_pool != nullptr) {
+            vkDestroyQueryPool(device_.Handle(), frame.statistics_pool, nullptr);
+        }
+        if (frame.occlusion_pool != nullptr) {
+            vkDestroyQueryPool(device_.Handle(), frame.occlusion_pool, nullptr);
+        }
+    }
+}
+
+bool PipelineStatistics::Enabled() const {
+    return enabled_;
+}
+
+void PipelineStatistics::SetTargetExtent(uint32_t width, uint32_t height) {
+    target_pixels_ = static_cast<uint64_t>(width) * height;
+}
+
+void PipelineStatistics::BeginFrame(VkCommandBuffer command_buffer, uint32_t frame_index) {
+    if (!enabled_) {
+        return;
+    }
+    current_ = &frames_[frame_index % frames_.size()];
+    CollectResults(*current_);
+    vkCmdResetQueryPool(command_buffer, current_->statistics_pool, 0, max_passes_);
+    vkCmdResetQueryPool(command_buffer, current_->occlusion_pool, 0, max_passes_);
+    ++frame_count_;
+    if (++frames_since_report_ >= REPORT_INTERVAL_) {
+        Report();
+    }
+}
+
+void PipelineStatistics::BeginPass(VkCommandBuffer command_buffer, const std::string& pass, const std::string& bucket) {
+#if !defined(NODEBUG)
+    // The pass itself is labelled by GpuProfiler; material buckets get a nested label of their own.
+    labels_.push_back(!bucket.empty());
+    if (!bucket.empty()) {
+        SERENITY_DEBUG_LABEL_BEGIN(command_buffer, bucket);
+    }
+#endif  // NODEBUG
+    // Only the BeginPass() that opened the query may end it, so nested passes record that they did not.
+    const auto opens = current_ != nullptr && !current_->open && current_->queries.size() < max_passes_;
+    opened_.push_back(opens);
+    if (!opens) {
+        return;
+    }
+    const auto query = static_cast<uint32_t>(current_->queries.size());
+    vkCmdBeginQuery(command_buffer, current_->statistics_pool, query, 0);
+    vkCmdBeginQuery(command_buffer, current_->occlusion_pool, query, occlusion_flags_);
+    current_->queries.push_back({pass, bucket});
+    current_->open = true;
+}
+
+void PipelineStatistics::EndPass(VkCommandBuffer command_buffer) {
+#if !defined(NODEBUG)
+    if (!labels_.empty()) {
+        if (labels_.back()) {
+            SERENITY_DEBUG_LABEL_END(command_buffer);
+        }
+        labels_.pop_back();
+    }
+#endif  // NODEBUG
+    if (opened_.empty()) {
+        return;
+    }
+    const auto opened = opened_.back();
+    opened_.pop_back();
+    if (!opened || current_ == nullptr || !current_->open) {
+        return;
+    }
+    const auto query = static_cast<uint32_t>(current_->queries.size() - 1);
+    vkCmdEndQuery(command_buffer, current_->occlusion_pool, query);
+    vkCmdEndQuery(command_buffer, current_->statistics_pool, query);
+    current_->open = false;
+}
+
+std::vector<PipelineStatisticsEntry> PipelineStatistics::Statistics() const {
+    std::vector<PipelineStatisticsEntry> entries;
+    entries.reserve(totals_.size());
+    for (const auto& [key, totals] : totals_) {
+        PipelineStatisticsEntry entry{key.first, key.second, totals.frames, {}, 0.0, 0.0, 0.0};
+        const auto& counters = totals.counters;
+        const auto frames = std::max<uint64_t>(totals.frames, 1);
+        entry.per_frame = {counters.input_vertices / frames, counters.input_primitives / frames, counters.vertex_invocations / frames, counters.clipping_invocations / frames, counters.clipping_primitives / frames, counters.fragment_invocations / frames, counters.compute_invocations / frames, counters.samples_passed / frames};
+        entry.overdraw = Ratio(entry.per_frame.fragment_invocations, target_pixels_);
+        entry.culled_primitives = counters.clipping_invocations == 0 ? 0.0 : 1.0 - Ratio(counters.clipping_primitives, counters.clipping_invocations);
+        entry.depth_rejected_fragments = counters.fragment_invocations == 0 ? 0.0 : 1.0 - Ratio(counters.samples_passed, counters.fragment_invocations);
+        entries.push_back(std::move(entry));
+    }
+    return entries;
+}
+
+void PipelineStatistics::Report() {
+    for (const auto& entry : Statistics()) {
+        logger_->info("Pipeline statistics {}{}{}: {} vertex invocations, {} primitives clipped in / {} out ({:.1f}% culled), {} fragment invocations (overdraw {:.2f}, {:.1f}% depth rejected), {} compute invocations per frame", entry.pass, entry.bucket.empty() ? "" : "/", entry.bucket, entry.per_frame.vertex_invocations, entry.per_frame.clipping_invocations, entry.per_frame.clipping_primitives, entry.culled_primitives * 100.0, entry.per_frame.fragment_invocations, entry.overdraw, entry.depth_rejected_fragments * 100.0, entry.per_frame.compute_invocations);
+    }
+    totals_.clear();
+    frames_since_report_ = 0;
+}
+
+void PipelineStatistics::CollectResults(Frame& frame) {
+    const auto count = static_cast<uint32_t>(frame.queries.size() - (frame.open ? 1 : 0));
+    if (count > 0) {
+        // Each result is its counters followed by an availability word.
+        std::vector<uint64_t> statistics(static_cast<size_t>(count) * (COUNTERS_ + 1));
+        std::vector<uint64_t> occlusion(static_cast<size_t>(count) * 2);
+        const auto flags = VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT;
+        const auto statistics_result = vkGetQueryPoolResults(device_.Handle(), frame.statistics_pool, 0, count, statistics.size() * sizeof(uint64_t), statistics.data(), (COUNTERS_ + 1) * sizeof(uint64_t), flags);
+        const auto occlusion_result = vkGetQueryPoolResults(device_.Handle(), frame.occlusion_pool, 0, count, occlusion.size() * sizeof(uint64_t), occlusion.data(), 2 * sizeof(uint64_t), flags);
+        const auto usable = [](VkResult result) {
+            return result == VK_SUCCESS || result == VK_NOT_READY;
+        };
+        if (usable(statistics_result) && usable(occlusion_result)) {
+            for (uint32_t i = 0; i < count; ++i) {
+                const auto* values = &statistics[static_cast<size_t>(i) * (COUNTERS_ + 1)];
+                if (values[COUNTERS_] == 0 || occlusion[i * 2 + 1] == 0) {
+                    continue;
+                }
+                const PipelineCounters counters{values[0], values[1], values[2], values[3], values[4], values[5], values[6], occlusion[i * 2]};
+                const auto& query = frame.queries[i];
+                for (const auto& key : {std::make_pair(query.pass, std::string()), std::make_pair(query.pass, query.bucket)}) {
+                    auto& totals = totals_[key];
+                    totals.counters += counters;
+                    if (totals.last_frame != frame_count_) {
+                        totals.last_frame = frame_count_;
+                        ++totals.frames;
+                    }
+                    if (query.bucket.empty()) {
+                        break;
+                    }
+                }
+            }
+        }
+    }
+    frame.queries.clear();
+    frame.open = false;
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,55 @@
+/**
+ * @file process_stats.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "process_stats.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+// windows.h must come first.
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#endif  // _WIN32
+
+namespace serenity {
+
+uint64_t PeakResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.PeakWorkingSetSize;
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+#endif  // __APPLE__
+#endif  // _WIN32
+}
+
+uint64_t CurrentResidentBytes() {
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters));
+    return counters.WorkingSetSize;
+#elif defined(__linux__)
+    std::ifstream statm("/proc/self/statm");
+    uint64_t size = 0;
+    uint64_t resident = 0;
+    statm >> size >> resident;
+    return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+    return PeakResidentBytes();
+#endif  // _WIN32
+}
+
+}  // namespace serenity
\ No newline at end of file
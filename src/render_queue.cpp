@@ -0,0 +1,146 @@
+/**
+ * @file render_queue.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "render_queue.h"
+
+#include <algorithm>
+#include <array>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+namespace {
+
+constexpr uint32_t DEPTH_SHIFT = 0;
+constexpr uint32_t MATERIAL_SHIFT = DEPTH_SHIFT + DrawKey::DEPTH_BITS;
+constexpr uint32_t PIPELINE_SHIFT = MATERIAL_SHIFT + DrawKey::MATERIAL_BITS;
+constexpr uint32_t PASS_SHIFT = PIPELINE_SHIFT + DrawKey::PIPELINE_BITS;
+static_assert(PASS_SHIFT + DrawKey::PASS_BITS == 64, "Draw key fields must fill 64 bits.");
+
+constexpr uint64_t Mask(uint32_t bits) {
+    return (uint64_t{1} << bits) - 1;
+}
+
+constexpr size_t BUCKETS = size_t{1} << RenderQueue::RADIX_BITS;
+
+}  // namespace
+
+uint64_t DrawKey::Pack() const {
+    return (pass & Mask(PASS_BITS)) << PASS_SHIFT | (pipeline & Mask(PIPELINE_BITS)) << PIPELINE_SHIFT | (material & Mask(MATERIAL_BITS)) << MATERIAL_SHIFT | (depth & Mask(DEPTH_BITS)) << DEPTH_SHIFT;
+}
+
+DrawKey DrawKey::Unpack(uint64_t key) {
+    return {static_cast<uint32_t>(key >> PASS_SHIFT & Mask(PASS_BITS)), static_cast<uint32_t>(key >> PIPELINE_SHIFT & Mask(PIPELINE_BITS)), static_cast<uint32_t>(key >> MATERIAL_SHIFT & Mask(MATERIAL_BITS)), static_cast<uint32_t>(key >> DEPTH_SHIFT & Mask(DEPTH_BITS))};
+}
+
+uint32_t DrawKey::DepthBucket(float depth, float near_plane, float far_plane, bool back_to_front) {
+    const auto range = far_plane - near_plane;
+    const auto normalized = range > 0.0F ? std::clamp((depth - near_plane) / range, 0.0F, 1.0F) : 0.0F;
+    const auto bucket = static_cast<uint32_t>(normalized * static_cast<float>(Mask(DEPTH_BITS)));
+    return back_to_front ? static_cast<uint32_t>(Mask(DEPTH_BITS)) - bucket : bucket;
+}
+
+void RenderQueue::Push(const DrawKey& key, uint32_t draw) {
+    items_.push_back({key.Pack(), draw});
+}
+
+void RenderQueue::Push(uint64_t key, uint32_t draw) {
+    items_.push_back({key, draw});
+}
+
+void RenderQueue::Append(const std::vector<DrawItem>& items) {
+    items_.insert(items_.end(), items.begin(), items.end());
+}
+
+void RenderQueue::Clear() {
+    items_.clear();
+}
+
+size_t RenderQueue::Size() const {
+    return items_.size();
+}
+
+void RenderQueue::Sort(ThreadPool& pool) {
+    SERENITY_ZONE_FUNCTION();
+    const auto count = items_.size();
+    if (count < 2) {
+        return;
+    }
+    scratch_.resize(count);
+    const auto blocks = (count + SORT_BLOCK - 1) / SORT_BLOCK;
+    auto block_range = [count](size_t block) {
+        return std::pair{block * SORT_BLOCK, std::min(count, (block + 1) * SORT_BLOCK)};
+    };
+
+    // Bits that differ from the first key anywhere in the queue; a digit with none of them set is already sorted.
+    std::vector<uint64_t> differences(blocks, 0);
+    const auto first = items_.front().key;
+    pool.ParallelFor(blocks, [this, &block_range, &differences, first](size_t block) {
+        const auto [begin, end] = block_range(block);
+        for (auto i = begin; i < end; ++i) {
+            differences[block] |= items_[i].key ^ first;
+        }
+    });
+    uint64_t varying = 0;
+    for (auto difference : differences) {
+        varying |= difference;
+    }
+
+    std::vector<std::array<uint32_t, BUCKETS>> offsets(blocks);
+    for (uint32_t shift = 0; shift < 64; shift += RADIX_BITS) {
+        if ((varying >> shift & Mask(RADIX_BITS)) == 0) {
+            continue;
+        }
+        pool.ParallelFor(blocks, [this, &block_range, &offsets, shift](size_t block) {
+            auto& histogram = offsets[block];
+            histogram.fill(0);
+            const auto [begin, end] = block_range(block);
+            for (auto i = begin; i < end; ++i) {
+                ++histogram[items_[i].key >> shift & Mask(RADIX_BITS)];
+            }
+        });
+        // Digit-major, block-minor prefix sum: each block scatters its items after those of earlier blocks with the
+        // same digit, which keeps the sort stable.
+        uint32_t offset = 0;
+        for (size_t digit = 0; digit < BUCKETS; ++digit) {
+            for (auto& histogram : offsets) {
+                const auto size = histogram[digit];
+                histogram[digit] = offset;
+                offset += size;
+            }
+        }
+        pool.ParallelFor(blocks, [this, &block_range, &offsets, shift](size_t block) {
+            auto& cursors = offsets[block];
+            const auto [begin, end] = block_range(block);
+            for (auto i = begin; i < end; ++i) {
+                scratch_[cursors[items_[i].key >> shift & Mask(RADIX_BITS)]++] = items_[i];
+            }
+        });
+        items_.swap(scratch_);
+    }
+}
+
+const std::vector<DrawItem>& RenderQueue::Items() const {
+    return items_;
+}
+
+RenderQueueStats RenderQueue::Stats() const {
+    RenderQueueStats stats;
+    stats.items = items_.size();
+    auto previous = items_.empty() ? 0 : ~items_.front().key;
+    for (const auto& item : items_) {
+        // A pipeline bind is needed whenever the pass or pipeline changes, a material bind whenever any of the three
+        // does.
+        stats.passes += (item.key >> PASS_SHIFT) != (previous >> PASS_SHIFT) ? 1 : 0;
+        stats.pipeline_binds += (item.key >> PIPELINE_SHIFT) != (previous >> PIPELINE_SHIFT) ? 1 : 0;
+        stats.material_binds += (item.key >> MATERIAL_SHIFT) != (previous >> MATERIAL_SHIFT) ? 1 : 0;
+        previous = item.key;
+    }
+    return stats;
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,205 @@
+/**
+ * @file residency_manager.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "residency_manager.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpu_profiler.h"
+#include "flight_recorder.h"
+
+namespace serenity {
+
+namespace {
+
+double Megabytes(VkDeviceSize bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+}  // namespace
+
+const char* ResourceCategoryName(ResourceCategory category) {
+    switch (category) {
+        case ResourceCategory::TEXTURE:
+            return "texture";
+        case ResourceCategory::GEOMETRY:
+            return "geometry";
+        case ResourceCategory::RENDER_TARGET:
+            return "render_target";
+        case ResourceCategory::STAGING:
+            return "staging";
+    }
+    return "unknown";
+}
+
+ResidencyManager::ResidencyManager(const Device& device, double budget_fraction, const std::shared_ptr<spdlog::logger>& logger) : device_(device), budget_fraction_(budget_fraction), logger_(logger) {
+    vkGetPhysicalDeviceMemoryProperties(device_.PhysicalDevice(), &memory_properties_);
+    if (device_.MemoryBudgetEnabled()) {
+        get_memory_properties2_ = reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(vkGetInstanceProcAddr(device_.GetInstance().Handle(), "vkGetPhysicalDeviceMemoryProperties2KHR"));
+    }
+    if (device_.PageableMemoryEnabled()) {
+        set_memory_priority_ = reinterpret_cast<PFN_vkSetDeviceMemoryPriorityEXT>(vkGetDeviceProcAddr(device_.Handle(), "vkSetDeviceMemoryPriorityEXT"));
+    }
+    if (get_memory_properties2_ == nullptr) {
+        logger_->warn("VK_EXT_memory_budget is not available, assuming {:.0f}% of each heap is usable", FALLBACK_BUDGET_SHARE_ * 100.0);
+    }
+    heaps_.resize(memory_properties_.memoryHeapCount);
+    for (uint32_t i = 0; i < memory_properties_.memoryHeapCount; ++i) {
+        heaps_[i].heap_index = i;
+        heaps_[i].device_local = (memory_properties_.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        heaps_[i].size = memory_properties_.memoryHeaps[i].size;
+    }
+    QueryBudget();
+}
+
+ResidencyManager::ResourceId ResidencyManager::Register(ResourceCategory category, uint32_t memory_type_index, VkDeviceSize size, float priority, VkDeviceMemory memory, EvictCallback evict) {
+    if (memory_type_index >= memory_properties_.memoryTypeCount) {
+        throw std::runtime_error("Invalid memory type index for resident resource.");
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto id = next_id_++;
+    const auto heap_index = memory_properties_.memoryTypes[memory_type_index].heapIndex;
+    resources_.emplace(id, Resource{category, heap_index, size, std::clamp(priority, 0.0f, 1.0f), memory, std::move(evict)});
+    heaps_[heap_index].categories[static_cast<size_t>(category)] += size;
+    FlightRecorder::Get().RecordAllocation(ResourceCategoryName(category), heap_index, static_cast<int64_t>(size));
+    return id;
+}
+
+void ResidencyManager::Unregister(ResourceId id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = resources_.find(id);
+    if (iter == resources_.end()) {
+        return;
+    }
+    heaps_[iter->second.heap_index].categories[static_cast<size_t>(iter->second.category)] -= iter->second.size;
+    FlightRecorder::Get().RecordAllocation(ResourceCategoryName(iter->second.category), iter->second.heap_index, -static_cast<int64_t>(iter->second.size));
+    resources_.erase(iter);
+}
+
+void ResidencyManager::Resize(ResourceId id, VkDeviceSize size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = resources_.find(id);
+    if (iter == resources_.end()) {
+        return;
+    }
+    auto& tracked = heaps_[iter->second.heap_index].categories[static_cast<size_t>(iter->second.category)];
+    tracked = tracked - iter->second.size + size;
+    FlightRecorder::Get().RecordAllocation(ResourceCategoryName(iter->second.category), iter->second.heap_index, static_cast<int64_t>(size) - static_cast<int64_t>(iter->second.size));
+    iter->second.size = size;
+}
+
+void ResidencyManager::SetPriority(ResourceId id, float priority) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto iter = resources_.find(id);
+    if (iter == resources_.end()) {
+        return;
+    }
+    iter->second.priority = std::clamp(priority, 0.0f, 1.0f);
+    // Without pageable device local memory the priority is fixed at allocation and only orders our own evictions.
+    if (set_memory_priority_ != nullptr && iter->second.memory != nullptr) {
+        set_memory_priority_(device_.Handle(), iter->second.memory, iter->second.priority);
+    }
+}
+
+void ResidencyManager::SetBudgetFraction(double budget_fraction) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    budget_fraction_ = budget_fraction;
+}
+
+void ResidencyManager::Tick() {
+    SERENITY_ZONE_FUNCTION();
+    std::lock_guard<std::mutex> lock(mutex_);
+    QueryBudget();
+    for (auto& heap : heaps_) {
+        const auto limit = static_cast<VkDeviceSize>(static_cast<double>(heap.budget) * budget_fraction_);
+        const auto over_budget = heap.usage > limit && !Evict(heap, limit);
+        if (over_budget == heap.over_budget) {
+            continue;
+        }
+        heap.over_budget = over_budget;
+        if (over_budget) {
+            logger_->warn("Memory heap {} over budget by {:.1f} MiB with nothing left to evict", heap.heap_index, Megabytes(heap.usage - limit));
+        } else {
+            logger_->info("Memory heap {} back within budget", heap.heap_index);
+        }
+    }
+}
+
+std::vector<HeapUsage> ResidencyManager::Heaps() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return heaps_;
+}
+
+uint64_t ResidencyManager::Evictions() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return evictions_;
+}
+
+void ResidencyManager::QueryBudget() {
+    if (get_memory_properties2_ != nullptr) {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budget{};
+        budget.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+        VkPhysicalDeviceMemoryProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+        properties.pNext = &budget;
+        get_memory_properties2_(device_.PhysicalDevice(), &properties);
+        for (auto& heap : heaps_) {
+            heap.budget = budget.heapBudget[heap.heap_index];
+            heap.usage = budget.heapUsage[heap.heap_index];
+        }
+        return;
+    }
+    // Without the extension only our own allocations are visible, other processes and the driver are not.
+    for (auto& heap : heaps_) {
+        heap.budget = static_cast<VkDeviceSize>(static_cast<double>(heap.size) * FALLBACK_BUDGET_SHARE_);
+        heap.usage = 0;
+        for (auto bytes : heap.categories) {
+            heap.usage += bytes;
+        }
+    }
+}
+
+bool ResidencyManager::Evict(HeapUsage& heap, VkDeviceSize limit) {
+    std::vector<std::pair<ResourceId, Resource*>> candidates;
+    for (auto& [id, resource] : resources_) {
+        if (resource.heap_index == heap.heap_index && resource.evict) {
+            candidates.emplace_back(id, &resource);
+        }
+    }
+    // Lowest priority first; among equals the largest goes first so fewer resources are touched.
+    std::sort(candidates.begin(), candidates.end(), [](const auto& lhs, const auto& rhs) {
+        if (lhs.second->priority != rhs.second->priority) {
+            return lhs.second->priority < rhs.second->priority;
+        }
+        return lhs.second->size > rhs.second->size;
+    });
+    const auto over = heap.usage - limit;
+    VkDeviceSize freed = 0;
+    size_t evicted = 0;
+    for (auto& [id, resource] : candidates) {
+        if (freed >= over) {
+            break;
+        }
+        const auto released = std::min(resource->evict(), resource->size);
+        if (released == 0) {
+            continue;
+        }
+        resource->size -= released;
+        heap.categories[static_cast<size_t>(resource->category)] -= released;
+        FlightRecorder::Get().RecordAllocation(ResourceCategoryName(resource->category), heap.heap_index, -static_cast<int64_t>(released));
+        freed += released;
+        ++evicted;
+    }
+    heap.usage -= std::min(freed, heap.usage);
+    evictions_ += evicted;
+    if (evicted > 0) {
+        logger_->info("Memory heap {} evicted {} resources, {:.1f} MiB freed", heap.heap_index, evicted, Megabytes(freed));
+    }
+    return freed >= over;
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,261 @@
+/**
+ * @file scene_loader.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "scene_loader.h"
+
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "json.hpp"
+
+namespace serenity {
+
+namespace {
+
+class SceneSaxHandler {
+public:
+    SceneSaxHandler(const SceneLoader::AssetCallback& on_asset, const SceneLoader::EntityCallback& on_entity) : on_asset_(on_asset), on_entity_(on_entity) {}
+
+    bool null() {
+        return Scalar();
+    }
+
+    bool boolean(bool /*value*/) {
+        return Scalar();
+    }
+
+    bool number_integer(nlohmann::json::number_integer_t value) {
+        return Number(static_cast<double>(value), value);
+    }
+
+    bool number_unsigned(nlohmann::json::number_unsigned_t value) {
+        return Number(static_cast<double>(value), static_cast<int64_t>(value));
+    }
+
+    bool number_float(nlohmann::json::number_float_t value, const nlohmann::json::string_t& /*text*/) {
+        return Number(value, static_cast<int64_t>(value));
+    }
+
+    bool string(nlohmann::json::string_t& value) {
+        if (Skipping() || Top() != State::ITEM) {
+            return Scalar();
+        }
+        if (section_ == Section::ASSETS) {
+            if (field_ == "id") {
+                asset_.id = std::move(value);
+            } else if (field_ == "path") {
+                asset_.path = std::move(value);
+            } else if (field_ == "type") {
+                asset_.type = std::move(value);
+            } else {
+                ++stats_.skipped_values;
+            }
+        } else {
+            if (field_ == "name") {
+                entity_.name = std::move(value);
+            } else if (field_ == "mesh") {
+                entity_.mesh = std::move(value);
+            } else if (field_ == "material") {
+                entity_.material = std::move(value);
+            } else {
+                ++stats_.skipped_values;
+            }
+        }
+        return true;
+    }
+
+    bool binary(nlohmann::json::binary_t& /*value*/) {
+        return Scalar();
+    }
+
+    bool start_object(std::size_t /*elements*/) {
+        if (Skipping()) {
+            ++skip_depth_;
+        } else if (states_.empty()) {
+            states_.push_back(State::ROOT);
+        } else if (Top() == State::SECTION) {
+            states_.push_back(State::ITEM);
+            asset_ = {};
+            entity_ = {};
+        } else {
+            Skip();
+        }
+        return true;
+    }
+
+    bool end_object() {
+        if (Skipping()) {
+            --skip_depth_;
+            return true;
+        }
+        if (Top() == State::ITEM) {
+            Emit();
+        }
+        states_.pop_back();
+        return true;
+    }
+
+    bool start_array(std::size_t /*elements*/) {
+        if (Skipping()) {
+            ++skip_depth_;
+        } else if (Top() == State::ROOT && (field_ == "assets" || field_ == "entities")) {
+            section_ = field_ == "assets" ? Section::ASSETS : Section::ENTITIES;
+            states_.push_back(State::SECTION);
+        } else if (Top() == State::ITEM && section_ == Section::ENTITIES && (field_ == "position" || field_ == "rotation" || field_ == "scale")) {
+            vector_ = {};
+            vector_size_ = 0;
+            states_.push_back(State::VECTOR);
+        } else {
+            Skip();
+        }
+        return true;
+    }
+
+    bool end_array() {
+        if (Skipping()) {
+            --skip_depth_;
+            return true;
+        }
+        if (Top() == State::VECTOR) {
+            AssignVector();
+        }
+        states_.pop_back();
+        return true;
+    }
+
+    bool key(nlohmann::json::string_t& value) {
+        if (!Skipping()) {
+            field_ = std::move(value);
+        }
+        return true;
+    }
+
+    bool parse_error(std::size_t position, const std::string& /*token*/, const nlohmann::detail::exception& e) {
+        throw std::runtime_error("Scene parse error at byte " + std::to_string(position) + ": " + e.what());
+    }
+
+    const SceneLoadStats& Stats() const {
+        return stats_;
+    }
+
+private:
+    enum class State {
+        ROOT,
+        SECTION,
+        ITEM,
+        VECTOR,
+    };
+
+    enum class Section {
+        ASSETS,
+        ENTITIES,
+    };
+
+private:
+    // Everything but an object at the top level ends up here with an empty stack.
+    State Top() const {
+        if (states_.empty()) {
+            throw std::runtime_error("Scene root must be an object.");
+        }
+        return states_.back();
+    }
+
+    bool Skipping() const {
+        return skip_depth_ > 0;
+    }
+
+    void Skip() {
+        skip_depth_ = 1;
+        ++stats_.skipped_values;
+    }
+
+    bool Scalar() {
+        if (!Skipping() && Top() != State::ROOT) {
+            ++stats_.skipped_values;
+        }
+        return true;
+    }
+
+    bool Number(double value, int64_t integer) {
+        if (Skipping()) {
+            return true;
+        }
+        if (Top() == State::VECTOR) {
+            if (vector_size_ < 4) {
+                vector_[vector_size_] = static_cast<float>(value);
+            }
+            ++vector_size_;
+        } else if (Top() == State::ITEM && section_ == Section::ENTITIES && field_ == "parent") {
+            entity_.parent = integer;
+        } else {
+            return Scalar();
+        }
+        return true;
+    }
+
+    void AssignVector() {
+        if (field_ == "rotation") {
+            if (vector_size_ != 4) {
+                throw std::runtime_error("Entity rotation must be a quaternion [x, y, z, w].");
+            }
+            entity_.rotation = glm::quat(vector_.w, vector_.x, vector_.y, vector_.z);
+            return;
+        }
+        if (vector_size_ != 3) {
+            throw std::runtime_error("Entity " + field_ + " must have three components.");
+        }
+        if (field_ == "position") {
+            entity_.position = glm::vec3(vector_);
+        } else {
+            entity_.scale = glm::vec3(vector_);
+        }
+    }
+
+    void Emit() {
+        if (section_ == Section::ASSETS) {
+            ++stats_.assets;
+            if (on_asset_) {
+                on_asset_(asset_);
+            }
+        } else {
+            ++stats_.entities;
+            if (on_entity_) {
+                on_entity_(entity_);
+            }
+        }
+    }
+
+private:
+    const SceneLoader::AssetCallback& on_asset_;
+    const SceneLoader::EntityCallback& on_entity_;
+    std::vector<State> states_{};
+    Section section_{Section::ASSETS};
+    std::string field_{};
+    size_t skip_depth_{0};
+    glm::vec4 vector_{0.0F};
+    size_t vector_size_{0};
+    AssetDesc asset_{};
+    EntityDesc entity_{};
+    SceneLoadStats stats_{};
+};
+
+}  // namespace
+
+SceneLoader::SceneLoader(AssetCallback on_asset, EntityCallback on_entity) : on_asset_(std::move(on_asset)), on_entity_(std::move(on_entity)) {}
+
+SceneLoadStats SceneLoader::Load(const std::filesystem::path& path) {
+    std::unique_ptr<std::FILE, decltype(&std::fclose)> file(std::fopen(path.string().c_str(), "rb"), &std::fclose);
+    if (!file) {
+        throw std::runtime_error("Failed to open scene " + path.string() + ".");
+    }
+    SceneSaxHandler handler(on_asset_, on_entity_);
+    nlohmann::json::sax_parse(file.get(), &handler);
+    return handler.Stats();
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -6,24 +6,390 @@
 
 #include "serenity.h"
 
-#include <fstream>
+#include <stdexcept>
 
+#include "cpu_profiler.h"
+#include "flight_recorder.h"
 #include "spdlog/sinks/basic_file_sink.h"
 
 namespace serenity {
 
-Serenity::Serenity() {
-    config_ = nlohmann::json::parse(std::ifstream("serenity.json"));
-    logger_ = spdlog::basic_logger_mt(config_["log_name"].get<std::string>(), config_["log_path"].get<std::string>() + "log");
-    logger_->set_level(spdlog::level::trace);
-    window_ = std::make_unique<Window>("serenity", 800, 600, logger_);
-    instance_ = std::make_unique<Instance>(logger_);
+Serenity::Serenity(const std::filesystem::path& config_path) {
+    Startup startup;
+    startup.AddStage("config", {}, Startup::Affinity::WORKER, [this, &config_path]() {
+        config_ = std::make_unique<Config>(config_path);
+    });
+    startup.AddStage("logger", {"config"}, Startup::Affinity::WORKER, [this]() {
+        CreateLogger();
+        config_->SetLogger(logger_);
+        const auto& settings = config_->Get();
+        FlightRecorder::Get().Configure(settings.flight_recorder_window, settings.hitch_budget, settings.flight_recorder_path);
+        FlightRecorder::Get().InstallCrashHandler();
+    });
+    startup.AddStage("glfw", {"config"}, Startup::Affinity::MAIN_THREAD, [this]() {
+        if (config_->Get().headless) {
+            return;
+        }
+        if (glfwInit() != GLFW_TRUE) {
+            throw std::runtime_error("Failed to initialize GLFW.");
+        }
+    });
+    startup.AddStage("window", {"logger", "glfw"}, Startup::Affinity::MAIN_THREAD, [this]() {
+        const auto& settings = config_->Get();
+        if (settings.headless) {
+            return;
+        }
+        window_ = std::make_unique<Window>(settings.window_title, settings.window_width, settings.window_height, logger_);
+    });
+    startup.AddStage("instance", {"logger", "glfw"}, Startup::Affinity::WORKER, [this]() {
+        instance_ = std::make_unique<Instance>(logger_);
+    });
+    startup.AddStage("device", {"instance"}, Startup::Affinity::WORKER, [this]() {
+        device_ = std::make_unique<Device>(*instance_, logger_);
+        gpu_profiler_ = std::make_unique<GpuProfiler>(*device_, config_->Get().frames_in_flight, config_->Get().gpu_profiler_max_passes, logger_);
+        if (config_->Get().gpu_pipeline_statistics) {
+            pipeline_statistics_ = std::make_unique<PipelineStatistics>(*device_, config_->Get().frames_in_flight, config_->Get().gpu_profiler_max_passes, logger_);
+        }
+        residency_ = std::make_unique<ResidencyManager>(*device_, config_->Get().memory_budget_fraction, logger_);
+    });
+    startup.AddStage("simulation", {"config", "logger"}, Startup::Affinity::WORKER, [this]() {
+        CreateSimulation();
+    });
+    startup.AddStage("frame_pacer", {"config", "logger"}, Startup::Affinity::WORKER, [this]() {
+        frame_pacer_ = std::make_unique<FramePacer>(config_->Get().target_frame_time, config_->Get().max_queued_frames, logger_);
+    });
+    startup.AddStage("thread_pool", {}, Startup::Affinity::WORKER, [this]() {
+        thread_pool_ = std::make_unique<ThreadPool>();
+    });
+    startup.Run();
+    startup.Report(logger_);
+    startup_timings_ = startup.Timings();
+    const auto& settings = config_->Get();
+    clear_color_ = {settings.clear_color_red, settings.clear_color_green, settings.clear_color_blue, settings.clear_color_alpha};
+    continuous_rendering_ = settings.continuous_rendering;
+    idle_wait_timeout_ = settings.idle_wait_timeout;
+    instance_batcher_.SetThreshold(settings.instancing_threshold);
+    if (window_) {
+        frame_pacer_->SetEventWaiter([this](std::chrono::nanoseconds timeout) {
+            window_->WaitEvents(std::chrono::duration<double>(timeout).count());
+        });
+    }
+    lod_selector_.SetSettings({settings.lod_pixel_error, settings.lod_hysteresis, static_cast<float>(settings.lod_fade_time)});
+    RegisterMetrics();
+    CreateMetricsServer(settings.metrics_port);
 }
 
 void Serenity::Loop() {
+    SERENITY_ZONE_THREAD_NAME("main");
+    if (!window_) {
+        throw std::runtime_error("A headless Serenity has no window to loop on, call Frame() instead.");
+    }
+    StartSimulation();
+    simulating_ = true;
     while (!window_->ShouleClose()) {
-        glfwPollEvents();
+        Frame();
+    }
+    simulation_->Stop();
+    simulating_ = false;
+#if defined(SERENITY_ENABLE_PROFILING)
+    if (!config_->Get().profile_capture_path.empty()) {
+        CpuProfiler::Get().Export(config_->Get().profile_capture_path);
+        logger_->info("Wrote profile capture {}", config_->Get().profile_capture_path);
+    }
+#endif  // SERENITY_ENABLE_PROFILING
+}
+
+void Serenity::Frame() {
+    SERENITY_ZONE("Serenity::Frame");
+    if (config_->Poll()) {
+        ApplyConfig(config_->Previous(), config_->Get());
+    }
+    // A minimized or hidden window has nothing to present; sleep until it comes back or the timer fires.
+    if (window_ && (window_->IsMinimized() || !window_->IsVisible())) {
+        window_->WaitEvents(idle_wait_timeout_);
+        return;
+    }
+    // Pace before sampling input so the frame is built from the freshest input available.
+    frame_pacer_->BeginFrame();
+    auto& recorder = FlightRecorder::Get();
+    const auto events_begin = FlightRecorder::Clock::now();
+    // Headless frames have no events to wait for and always render.
+    if (window_ && (continuous_rendering_ || redraw_requested_.load())) {
+        window_->PollEvents();
+    } else if (window_) {
+        window_->WaitEvents(idle_wait_timeout_);
+    }
+    redraw_requested_ = false;
+    // Waiting for events is idle time, so the hitch budget only covers the work after it.
+    const auto frame_begin = FlightRecorder::Clock::now();
+    recorder.RecordZone("Events", events_begin, frame_begin);
+    residency_->Tick();
+    if (!simulating_) {
+        // Frames driven without Loop() have no simulation thread; the main thread owns the scene and publishes it.
+        PublishState(Simulation::Clock::now());
+    }
+    if (render_) {
+        SERENITY_ZONE("Serenity::Render");
+        const auto states = states_.Acquire();
+        render_(states.previous, states.current, simulating_ ? simulation_->Alpha(states.current.time) : 1.0);
+        recorder.RecordZone("Render", frame_begin, FlightRecorder::Clock::now());
+    }
+    const auto queue_stats = render_queue_.Stats();
+    draw_items_->Set(static_cast<double>(queue_stats.items));
+    pipeline_binds_->Set(static_cast<double>(queue_stats.pipeline_binds));
+    material_binds_->Set(static_cast<double>(queue_stats.material_binds));
+    render_queue_.Clear();
+    draws_saved_->Set(static_cast<double>(instance_batcher_.Stats().draws_saved));
+    instance_batcher_.Clear();
+    frame_pacer_->EndFrame(window_ ? window_->ConsumeInputTime() : std::nullopt);
+    const auto frame_end = FlightRecorder::Clock::now();
+    frames_->Increment();
+    frame_time_->Observe(std::chrono::duration<double>(frame_end - frame_begin).count());
+    const auto dump = recorder.EndFrame(frame_begin, frame_end);
+    if (!dump.empty()) {
+        logger_->warn("Frame exceeded the hitch budget, writing flight recorder trace {}", dump.string());
+    }
+}
+
+void Serenity::SetUpdateCallback(UpdateCallback update) {
+    update_ = std::move(update);
+}
+
+void Serenity::SetRenderCallback(RenderCallback render) {
+    render_ = std::move(render);
+}
+
+void Serenity::SetContinuousRendering(bool continuous) {
+    continuous_rendering_ = continuous;
+    RequestRedraw();
+}
+
+void Serenity::RequestRedraw() {
+    redraw_requested_ = true;
+    if (window_) {
+        window_->Wake();
+    }
+}
+
+const std::vector<StageTiming>& Serenity::StartupTimings() const {
+    return startup_timings_;
+}
+
+const std::array<float, 4>& Serenity::ClearColor() const {
+    return clear_color_;
+}
+
+GpuProfiler& Serenity::Profiler() {
+    return *gpu_profiler_;
+}
+
+const Device& Serenity::GetDevice() const {
+    return *device_;
+}
+
+PipelineStatistics* Serenity::PipelineStats() {
+    return pipeline_statistics_.get();
+}
+
+ResidencyManager& Serenity::Residency() {
+    return *residency_;
+}
+
+MetricsRegistry& Serenity::Metrics() {
+    return metrics_;
+}
+
+ThreadPool& Serenity::Workers() {
+    return *thread_pool_;
+}
+
+World& Serenity::Scene() {
+    return world_;
+}
+
+TransformHierarchy& Serenity::Transforms() {
+    return transforms_;
+}
+
+Bvh& Serenity::StaticBounds() {
+    return static_bounds_;
+}
+
+SpatialHashGrid& Serenity::DynamicBounds() {
+    return dynamic_bounds_;
+}
+
+RenderQueue& Serenity::Queue() {
+    return render_queue_;
+}
+
+InstanceBatcher& Serenity::Batcher() {
+    return instance_batcher_;
+}
+
+LodSelector& Serenity::Lods() {
+    return lod_selector_;
+}
+
+void Serenity::CreateLogger() {
+    // Route through a dist sink so a changed log_path can swap the file sink while other threads keep logging.
+    log_sink_ = std::make_shared<spdlog::sinks::dist_sink_mt>();
+    const auto& settings = config_->Get();
+    log_sink_->add_sink(std::make_shared<spdlog::sinks::basic_file_sink_mt>(settings.log_path + "log"));
+    log_sink_->add_sink(FlightRecorder::Get().LogSink());
+    logger_ = std::make_shared<spdlog::logger>(settings.log_name, log_sink_);
+    logger_->set_level(spdlog::level::from_str(settings.log_level));
+    spdlog::register_logger(logger_);
+}
+
+void Serenity::CreateSimulation() {
+    if (simulation_) {
+        simulation_->Stop();
+    }
+    simulation_ = std::make_unique<Simulation>(config_->Get().simulation_rate, config_->Get().max_simulation_steps, logger_);
+    if (simulating_) {
+        StartSimulation();
+    }
+}
+
+void Serenity::StartSimulation() {
+    simulation_->Start([this, update = update_](double dt, Simulation::Clock::time_point time) {
+        if (update) {
+            update(dt);
+        }
+        PublishState(time);
+    });
+}
+
+void Serenity::PublishState(Simulation::Clock::time_point time) {
+    SERENITY_ZONE_FUNCTION();
+    transforms_.Update(*thread_pool_);
+    if (static_bounds_.NeedsRefit()) {
+        static_bounds_.Refit();
+        bvh_degradation_->Set(static_bounds_.Degradation());
+    }
+    if (dynamic_bounds_.NeedsRebuild()) {
+        dynamic_bounds_.Rebuild(*thread_pool_);
+        grid_objects_->Set(static_cast<double>(dynamic_bounds_.Size()));
+    }
+    auto& state = states_.Begin();
+    state.tick = ++published_ticks_;
+    state.time = time;
+    transforms_.CopyWorlds(state.world, state.generation);
+    state.generation = transforms_.Generation();
+    states_.Publish();
+}
+
+void Serenity::RegisterMetrics() {
+    frames_ = &metrics_.AddCounter("serenity_frames_total", "Frames rendered.");
+    frame_time_ = &metrics_.AddHistogram("serenity_frame_seconds", "CPU time of a frame after event handling.", {0.001, 0.002, 0.004, 0.008, 0.0167, 0.0333, 0.05, 0.1, 0.25, 0.5, 1.0});
+    // Bumped by the code that submits, draws, uploads and looks up pipelines, which adds the same series by name.
+    metrics_.AddCounter("serenity_queue_submits_total", "Queue submissions.");
+    metrics_.AddCounter("serenity_draw_calls_total", "Draw calls recorded.");
+    draw_items_ = &metrics_.AddGauge("serenity_render_queue_items", "Draws in the render queue last frame.");
+    pipeline_binds_ = &metrics_.AddGauge("serenity_render_pipeline_binds", "Pipeline binds the render queue order needed last frame.");
+    draws_saved_ = &metrics_.AddGauge("serenity_render_draws_saved", "Draws folded into instanced draws last frame.");
+    material_binds_ = &metrics_.AddGauge("serenity_render_material_binds", "Material descriptor binds the render queue order needed last frame.");
+    bvh_degradation_ = &metrics_.AddGauge("serenity_bvh_degradation", "SAH cost of the static bounds BVH relative to its last build.");
+    grid_objects_ = &metrics_.AddGauge("serenity_spatial_grid_objects", "Objects in the dynamic bounds grid.");
+    metrics_.AddCounter("serenity_upload_bytes_total", "Bytes uploaded to the GPU.");
+    metrics_.AddCounter("serenity_pipeline_cache_hits_total", "Pipeline lookups served from the cache.");
+    metrics_.AddCounterCallback("serenity_pipeline_compiles_total", "Pipelines compiled.", {}, [this]() {
+        return static_cast<double>(device_->PipelineCompiles());
+    });
+    for (const auto& [severity, name] : {std::pair{VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT, "info"}, std::pair{VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT, "warning"}, std::pair{VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT, "error"}}) {
+        metrics_.AddCounterCallback("serenity_validation_messages_total", "Messages from the validation layers.", {{"severity", name}}, [this, severity]() {
+            return static_cast<double>(instance_->ValidationMessages(severity));
+        });
+    }
+    metrics_.AddCounterCallback("serenity_memory_evictions_total", "Resources evicted to stay within the memory budget.", {}, [this]() {
+        return static_cast<double>(residency_->Evictions());
+    });
+    for (const auto& heap : residency_->Heaps()) {
+        const auto index = heap.heap_index;
+        const MetricLabels labels{{"heap", std::to_string(index)}};
+        metrics_.AddGaugeCallback("serenity_memory_heap_budget_bytes", "Memory heap budget.", labels, [this, index]() {
+            return static_cast<double>(residency_->Heaps()[index].budget);
+        });
+        metrics_.AddGaugeCallback("serenity_memory_heap_usage_bytes", "Memory heap usage.", labels, [this, index]() {
+            return static_cast<double>(residency_->Heaps()[index].usage);
+        });
+        metrics_.AddGaugeCallback("serenity_memory_heap_over_budget", "1 while the heap is over budget with nothing left to evict.", labels, [this, index]() {
+            return residency_->Heaps()[index].over_budget ? 1.0 : 0.0;
+        });
+        for (size_t category = 0; category < RESOURCE_CATEGORY_COUNT; ++category) {
+            const MetricLabels category_labels{{"heap", std::to_string(index)}, {"category", ResourceCategoryName(static_cast<ResourceCategory>(category))}};
+            metrics_.AddGaugeCallback("serenity_memory_tracked_bytes", "Memory tracked by the residency manager.", category_labels, [this, index, category]() {
+                return static_cast<double>(residency_->Heaps()[index].categories[category]);
+            });
+        }
+    }
+}
+
+void Serenity::CreateMetricsServer(uint32_t port) {
+    metrics_server_.reset();
+    if (port != 0) {
+        metrics_server_ = std::make_unique<MetricsServer>(metrics_, static_cast<uint16_t>(port), logger_);
+    }
+}
+
+void Serenity::ApplyConfig(const Settings& previous, const Settings& current) {
+    try {
+        if (current.log_level != previous.log_level) {
+            logger_->set_level(spdlog::level::from_str(current.log_level));
+        }
+        if (current.log_path != previous.log_path) {
+            log_sink_->set_sinks({std::make_shared<spdlog::sinks::basic_file_sink_mt>(current.log_path + "log"), FlightRecorder::Get().LogSink()});
+        }
+        auto restart_required = [this](bool changed, const char* key) {
+            if (changed) {
+                logger_->warn("{} changes take effect after a restart", key);
+            }
+        };
+        restart_required(current.log_name != previous.log_name, "log_name");
+        restart_required(current.frames_in_flight != previous.frames_in_flight, "frames_in_flight");
+        restart_required(current.gpu_profiler_max_passes != previous.gpu_profiler_max_passes, "gpu_profiler_max_passes");
+        restart_required(current.gpu_pipeline_statistics != previous.gpu_pipeline_statistics, "gpu_pipeline_statistics");
+        restart_required(current.headless != previous.headless, "headless");
+        if (window_ && current.window_title != previous.window_title) {
+            window_->SetTitle(current.window_title);
+        }
+        if (window_ && (current.window_width != previous.window_width || current.window_height != previous.window_height)) {
+            window_->SetSize(current.window_width, current.window_height);
+        }
+        clear_color_ = {current.clear_color_red, current.clear_color_green, current.clear_color_blue, current.clear_color_alpha};
+        if (current.simulation_rate != previous.simulation_rate || current.max_simulation_steps != previous.max_simulation_steps) {
+            CreateSimulation();
+        }
+        if (current.continuous_rendering != previous.continuous_rendering) {
+            continuous_rendering_ = current.continuous_rendering;
+        }
+        idle_wait_timeout_ = current.idle_wait_timeout;
+        if (current.flight_recorder_window != previous.flight_recorder_window || current.hitch_budget != previous.hitch_budget || current.flight_recorder_path != previous.flight_recorder_path) {
+            FlightRecorder::Get().Configure(current.flight_recorder_window, current.hitch_budget, current.flight_recorder_path);
+        }
+        if (current.metrics_port != previous.metrics_port) {
+            CreateMetricsServer(current.metrics_port);
+        }
+        if (current.instancing_threshold != previous.instancing_threshold) {
+            instance_batcher_.SetThreshold(current.instancing_threshold);
+        }
+        if (current.lod_pixel_error != previous.lod_pixel_error || current.lod_hysteresis != previous.lod_hysteresis || current.lod_fade_time != previous.lod_fade_time) {
+            lod_selector_.SetSettings({current.lod_pixel_error, current.lod_hysteresis, static_cast<float>(current.lod_fade_time)});
+        }
+        if (current.memory_budget_fraction != previous.memory_budget_fraction) {
+            residency_->SetBudgetFraction(current.memory_budget_fraction);
+        }
+        if (current.target_frame_time != previous.target_frame_time) {
+            frame_pacer_->SetTargetFrameTime(current.target_frame_time);
+        }
+        if (current.max_queued_frames != previous.max_queued_frames) {
+            frame_pacer_->SetMaxQueuedFrames(current.max_queued_frames);
+        }
+    } catch (const std::exception& e) {
+        logger_->error("Failed to apply config: {}", e.what());
     }
+    RequestRedraw();
 }
 
 }  // namespace serenity
\ No newline at end of file
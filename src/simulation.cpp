@@ -0,0 +1,93 @@
+/**
+ * @file simulation.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "simulation.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+Simulation::Simulation(double tick_rate, uint32_t max_ticks_per_update, const std::shared_ptr<spdlog::logger>& logger) : max_ticks_per_update_(max_ticks_per_update), logger_(logger) {
+    if (tick_rate <= 0.0 || max_ticks_per_update == 0) {
+        throw std::runtime_error("Simulation tick rate and max ticks per update must be positive.");
+    }
+    tick_duration_ = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tick_rate));
+}
+
+Simulation::~Simulation() {
+    Stop();
+}
+
+void Simulation::Start(TickCallback tick) {
+    Stop();
+    tick_ = std::move(tick);
+    running_ = true;
+    thread_ = std::thread(&Simulation::Run, this);
+}
+
+void Simulation::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+        logger_->info("Simulation stopped after {} ticks, {} dropped", ticks_.load(), dropped_ticks_.load());
+    }
+}
+
+double Simulation::Alpha(Clock::time_point state_time) const {
+    const auto since_state = Clock::now() - state_time;
+    return std::clamp(static_cast<double>(since_state.count()) / static_cast<double>(tick_duration_.count()), 0.0, 1.0);
+}
+
+double Simulation::TickDuration() const {
+    return std::chrono::duration<double>(tick_duration_).count();
+}
+
+uint64_t Simulation::Ticks() const {
+    return ticks_.load(std::memory_order_relaxed);
+}
+
+void Simulation::Run() {
+    SERENITY_ZONE_THREAD_NAME("simulation");
+    const auto dt = TickDuration();
+    const auto max_lag = tick_duration_ * max_ticks_per_update_;
+    Clock::duration lag{0};
+    auto previous = Clock::now();
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_) {
+        lock.unlock();
+        const auto now = Clock::now();
+        lag += now - previous;
+        previous = now;
+        // Spiral-of-death protection: never try to catch up on more than max_ticks_per_update_ ticks at once.
+        if (lag > max_lag) {
+            const auto dropped = static_cast<uint64_t>((lag - max_lag) / tick_duration_);
+            dropped_ticks_.fetch_add(dropped, std::memory_order_relaxed);
+            logger_->warn("Simulation fell behind, dropping {} ticks", dropped);
+            lag = max_lag;
+        }
+        while (lag >= tick_duration_) {
+            lag -= tick_duration_;
+            if (tick_) {
+                SERENITY_ZONE("Simulation::Tick");
+                tick_(dt, now - lag);
+            }
+            ticks_.fetch_add(1, std::memory_order_relaxed);
+        }
+        lock.lock();
+        wake_.wait_until(lock, now + (tick_duration_ - lag), [this]() {
+            return !running_;
+        });
+    }
+}
+
+}  // namespace serenity
\ No newline at end of file
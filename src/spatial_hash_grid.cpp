@@ -0,0 +1,359 @@
+/**
+ * @file spatial_hash_grid.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "spatial_hash_grid.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+namespace {
+
+constexpr size_t MIN_BUCKETS = 64;
+constexpr size_t REBUILD_BLOCK = 16384;
+
+}  // namespace
+
+SpatialHashGrid::SpatialHashGrid(float cell_size) : cell_size_(cell_size), inverse_cell_size_(1.0F / cell_size) {
+    if (!(cell_size > 0.0F)) {
+        throw std::runtime_error("Spatial hash grid cell size must be positive.");
+    }
+    heads_.assign(MIN_BUCKETS, NONE);
+}
+
+GridObjectId SpatialHashGrid::Insert(const glm::vec3& position, float radius) {
+    // Keep the load factor at or below one.
+    if (positions_.size() + 1 > heads_.size()) {
+        Rehash(heads_.size() * 2);
+    }
+    const auto slot = static_cast<uint32_t>(positions_.size());
+    GridObjectId object;
+    if (free_ids_.empty()) {
+        object = static_cast<GridObjectId>(slots_.size());
+        slots_.push_back(slot);
+    } else {
+        object = free_ids_.back();
+        free_ids_.pop_back();
+        slots_[object] = slot;
+    }
+    const auto cell = CellOf(position);
+    positions_.push_back(position);
+    radii_.push_back(radius);
+    cells_.push_back(cell);
+    buckets_.push_back(BucketOf(cell));
+    next_.push_back(NONE);
+    previous_.push_back(NONE);
+    ids_.push_back(object);
+    Link(slot);
+    relinked_ = true;
+    max_radius_ = std::max(max_radius_, radius);
+    return object;
+}
+
+void SpatialHashGrid::Move(GridObjectId object, const glm::vec3& position) {
+    const auto slot = SlotOf(object);
+    positions_[slot] = position;
+    const auto cell = CellOf(position);
+    if (cell == cells_[slot]) {
+        return;
+    }
+    cells_[slot] = cell;
+    const auto bucket = BucketOf(cell);
+    if (bucket != buckets_[slot]) {
+        Unlink(slot);
+        buckets_[slot] = bucket;
+        Link(slot);
+        relinked_ = true;
+    }
+}
+
+void SpatialHashGrid::Remove(GridObjectId object) {
+    const auto slot = SlotOf(object);
+    Unlink(slot);
+    relinked_ = true;
+    slots_[object] = NONE;
+    free_ids_.push_back(object);
+    // Fill the hole with the last slot and point its list neighbours at the new place.
+    const auto last = static_cast<uint32_t>(positions_.size() - 1);
+    if (slot != last) {
+        positions_[slot] = positions_[last];
+        radii_[slot] = radii_[last];
+        cells_[slot] = cells_[last];
+        buckets_[slot] = buckets_[last];
+        next_[slot] = next_[last];
+        previous_[slot] = previous_[last];
+        ids_[slot] = ids_[last];
+        if (previous_[slot] != NONE) {
+            next_[previous_[slot]] = slot;
+        } else {
+            heads_[buckets_[slot]] = slot;
+        }
+        if (next_[slot] != NONE) {
+            previous_[next_[slot]] = slot;
+        }
+        slots_[ids_[slot]] = slot;
+    }
+    positions_.pop_back();
+    radii_.pop_back();
+    cells_.pop_back();
+    buckets_.pop_back();
+    next_.pop_back();
+    previous_.pop_back();
+    ids_.pop_back();
+}
+
+bool SpatialHashGrid::Alive(GridObjectId object) const {
+    return object < slots_.size() && slots_[object] != NONE;
+}
+
+const glm::vec3& SpatialHashGrid::Position(GridObjectId object) const {
+    return positions_[SlotOf(object)];
+}
+
+float SpatialHashGrid::Radius(GridObjectId object) const {
+    return radii_[SlotOf(object)];
+}
+
+size_t SpatialHashGrid::Size() const {
+    return positions_.size();
+}
+
+bool SpatialHashGrid::NeedsRebuild() const {
+    return relinked_;
+}
+
+size_t SpatialHashGrid::BucketCount() const {
+    return heads_.size();
+}
+
+float SpatialHashGrid::CellSize() const {
+    return cell_size_;
+}
+
+void SpatialHashGrid::Rebuild(ThreadPool& pool) {
+    SERENITY_ZONE_FUNCTION();
+    const auto count = positions_.size();
+    heads_.assign(std::max(MIN_BUCKETS, std::bit_ceil(count)), NONE);
+    relinked_ = false;
+    if (count == 0) {
+        max_radius_ = 0.0F;
+        return;
+    }
+    const auto blocks = (count + REBUILD_BLOCK - 1) / REBUILD_BLOCK;
+    auto for_each_block = [&pool, blocks, count](const auto& fn) {
+        pool.ParallelFor(blocks, [&fn, count](size_t block) {
+            const auto end = std::min(count, (block + 1) * REBUILD_BLOCK);
+            for (auto i = block * REBUILD_BLOCK; i < end; ++i) {
+                fn(static_cast<uint32_t>(i));
+            }
+        });
+    };
+
+    // Counting sort by bucket: histogram, exclusive prefix sum, scatter. The scatter claims places atomically, so
+    // objects within a bucket come out in no particular order.
+    std::vector<uint32_t> cursors(heads_.size(), 0);
+    for_each_block([this, &cursors](uint32_t slot) {
+        cells_[slot] = CellOf(positions_[slot]);
+        buckets_[slot] = BucketOf(cells_[slot]);
+        std::atomic_ref<uint32_t>(cursors[buckets_[slot]]).fetch_add(1, std::memory_order_relaxed);
+    });
+    uint32_t offset = 0;
+    for (auto& cursor : cursors) {
+        const auto size = cursor;
+        cursor = offset;
+        offset += size;
+    }
+    std::vector<uint32_t> order(count);
+    for_each_block([this, &cursors, &order](uint32_t slot) {
+        order[std::atomic_ref<uint32_t>(cursors[buckets_[slot]]).fetch_add(1, std::memory_order_relaxed)] = slot;
+    });
+
+    auto permute = [&for_each_block, &order](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted(values.size());
+        for_each_block([&sorted, &values, &order](uint32_t slot) {
+            sorted[slot] = values[order[slot]];
+        });
+        values.swap(sorted);
+    };
+    permute(positions_);
+    permute(radii_);
+    permute(cells_);
+    permute(buckets_);
+    permute(ids_);
+    max_radius_ = *std::max_element(radii_.begin(), radii_.end());
+    // Each bucket is now one run of slots; link the runs in slot order.
+    for_each_block([this, count](uint32_t slot) {
+        const auto bucket = buckets_[slot];
+        slots_[ids_[slot]] = slot;
+        previous_[slot] = slot > 0 && buckets_[slot - 1] == bucket ? slot - 1 : NONE;
+        next_[slot] = slot + 1 < count && buckets_[slot + 1] == bucket ? slot + 1 : NONE;
+        if (previous_[slot] == NONE) {
+            heads_[bucket] = slot;
+        }
+    });
+}
+
+void SpatialHashGrid::Overlap(const Aabb& box, std::vector<GridObjectId>& objects) const {
+    auto test = [this, &box, &objects](uint32_t slot) {
+        if (box.SquaredDistance(positions_[slot]) <= radii_[slot] * radii_[slot]) {
+            objects.push_back(ids_[slot]);
+        }
+    };
+    const Aabb range{box.min - max_radius_, box.max + max_radius_};
+    const auto visited = VisitCells(range, [this, &test](const glm::ivec3& cell) {
+        VisitObjects(cell, test);
+    });
+    if (!visited) {
+        for (uint32_t slot = 0; slot < positions_.size(); ++slot) {
+            test(slot);
+        }
+    }
+}
+
+void SpatialHashGrid::Nearby(const glm::vec3& center, float radius, std::vector<GridObjectId>& objects) const {
+    auto test = [this, &center, radius, &objects](uint32_t slot) {
+        const auto reach = radius + radii_[slot];
+        const auto offset = positions_[slot] - center;
+        if (glm::dot(offset, offset) <= reach * reach) {
+            objects.push_back(ids_[slot]);
+        }
+    };
+    const Aabb range{center - (radius + max_radius_), center + (radius + max_radius_)};
+    const auto visited = VisitCells(range, [this, &test](const glm::ivec3& cell) {
+        VisitObjects(cell, test);
+    });
+    if (!visited) {
+        for (uint32_t slot = 0; slot < positions_.size(); ++slot) {
+            test(slot);
+        }
+    }
+}
+
+void SpatialHashGrid::Cull(const Frustum& frustum, std::vector<GridObjectId>& objects) const {
+    auto test = [this, &frustum, &objects](uint32_t slot) {
+        if (frustum.Intersects(positions_[slot], radii_[slot])) {
+            objects.push_back(ids_[slot]);
+        }
+    };
+    auto range = frustum.Bounds();
+    range.min -= max_radius_;
+    range.max += max_radius_;
+    // A frustum with its far plane at infinity has no finite box to walk.
+    auto visited = false;
+    const auto finite = [](const glm::vec3& value) {
+        return !glm::any(glm::isinf(value)) && !glm::any(glm::isnan(value));
+    };
+    if (finite(range.min) && finite(range.max)) {
+        visited = VisitCells(range, [this, &frustum, &objects, &test](const glm::ivec3& cell) {
+            // Loose cell bounds: anything filed here lies within max_radius_ of the cell.
+            const auto min = glm::vec3(cell) * cell_size_ - max_radius_;
+            const auto max = glm::vec3(cell + 1) * cell_size_ + max_radius_;
+            switch (frustum.Classify({min, max})) {
+                case Containment::OUTSIDE:
+                    break;
+                case Containment::INSIDE:
+                    VisitObjects(cell, [this, &objects](uint32_t slot) {
+                        objects.push_back(ids_[slot]);
+                    });
+                    break;
+                case Containment::INTERSECTS:
+                    VisitObjects(cell, test);
+                    break;
+            }
+        });
+    }
+    if (!visited) {
+        for (uint32_t slot = 0; slot < positions_.size(); ++slot) {
+            test(slot);
+        }
+    }
+}
+
+glm::ivec3 SpatialHashGrid::CellOf(const glm::vec3& position) const {
+    return glm::ivec3(glm::floor(position * inverse_cell_size_));
+}
+
+uint32_t SpatialHashGrid::BucketOf(const glm::ivec3& cell) const {
+    const auto hash = static_cast<uint32_t>(cell.x) * 73856093U ^ static_cast<uint32_t>(cell.y) * 19349663U ^ static_cast<uint32_t>(cell.z) * 83492791U;
+    return hash & static_cast<uint32_t>(heads_.size() - 1);
+}
+
+uint32_t SpatialHashGrid::SlotOf(GridObjectId object) const {
+    if (!Alive(object)) {
+        throw std::runtime_error("Unknown spatial hash grid object " + std::to_string(object) + ".");
+    }
+    return slots_[object];
+}
+
+void SpatialHashGrid::Link(uint32_t slot) {
+    const auto bucket = buckets_[slot];
+    previous_[slot] = NONE;
+    next_[slot] = heads_[bucket];
+    if (heads_[bucket] != NONE) {
+        previous_[heads_[bucket]] = slot;
+    }
+    heads_[bucket] = slot;
+}
+
+void SpatialHashGrid::Unlink(uint32_t slot) {
+    if (previous_[slot] != NONE) {
+        next_[previous_[slot]] = next_[slot];
+    } else {
+        heads_[buckets_[slot]] = next_[slot];
+    }
+    if (next_[slot] != NONE) {
+        previous_[next_[slot]] = previous_[slot];
+    }
+}
+
+void SpatialHashGrid::Rehash(size_t buckets) {
+    heads_.assign(buckets, NONE);
+    for (uint32_t slot = 0; slot < positions_.size(); ++slot) {
+        buckets_[slot] = BucketOf(cells_[slot]);
+        Link(slot);
+    }
+}
+
+template <typename F>
+bool SpatialHashGrid::VisitCells(const Aabb& box, F&& visit) const {
+    if (box.Empty()) {
+        return true;
+    }
+    const auto first = CellOf(box.min);
+    const auto last = CellOf(box.max);
+    const auto span = glm::i64vec3(last) - glm::i64vec3(first) + int64_t{1};
+    if (span.x * span.y * span.z > static_cast<int64_t>(heads_.size())) {
+        return false;
+    }
+    glm::ivec3 cell;
+    for (cell.z = first.z; cell.z <= last.z; ++cell.z) {
+        for (cell.y = first.y; cell.y <= last.y; ++cell.y) {
+            for (cell.x = first.x; cell.x <= last.x; ++cell.x) {
+                visit(cell);
+            }
+        }
+    }
+    return true;
+}
+
+template <typename F>
+void SpatialHashGrid::VisitObjects(const glm::ivec3& cell, F&& visit) const {
+    // Other cells can share the bucket; only objects filed under this one count, so no object is visited twice.
+    for (auto slot = heads_[BucketOf(cell)]; slot != NONE; slot = next_[slot]) {
+        if (cells_[slot] == cell) {
+            visit(slot);
+        }
+    }
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+ * @file startup.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "startup.h"
+
+#include <algorithm>
+#include <exception>
+#include <future>
+#include <stdexcept>
+
+namespace serenity {
+
+void Startup::AddStage(const std::string& name, const std::vector<std::string>& dependencies, Affinity affinity, std::function<void()> task) {
+    Stage stage{name, {}, affinity, std::move(task)};
+    for (const auto& dependency : dependencies) {
+        auto iter = std::find_if(stages_.begin(), stages_.end(), [&dependency](const Stage& registered) {
+            return registered.name == dependency;
+        });
+        if (iter == stages_.end()) {
+            throw std::runtime_error("Startup stage " + name + " depends on unknown stage " + dependency + ".");
+        }
+        stage.dependencies.push_back(static_cast<size_t>(std::distance(stages_.begin(), iter)));
+    }
+    stages_.push_back(std::move(stage));
+}
+
+void Startup::Run() {
+    const auto begin = std::chrono::steady_clock::now();
+    timings_.assign(stages_.size(), {});
+    std::vector<std::promise<void>> promises(stages_.size());
+    std::vector<std::shared_future<void>> done;
+    done.reserve(stages_.size());
+    for (auto& promise : promises) {
+        done.push_back(promise.get_future().share());
+    }
+
+    auto execute = [this, begin, &promises, &done](size_t index) {
+        const auto& stage = stages_[index];
+        try {
+            for (auto dependency : stage.dependencies) {
+                done[dependency].get();
+            }
+            const auto start = std::chrono::steady_clock::now();
+            stage.task();
+            const auto end = std::chrono::steady_clock::now();
+            timings_[index] = {stage.name, start - begin, end - start, stage.affinity == Affinity::MAIN_THREAD};
+            promises[index].set_value();
+        } catch (...) {
+            timings_[index].name = stage.name;
+            promises[index].set_exception(std::current_exception());
+        }
+    };
+
+    std::vector<std::future<void>> workers;
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        if (stages_[i].affinity == Affinity::WORKER) {
+            workers.push_back(std::async(std::launch::async, execute, i));
+        }
+    }
+    // Every main-thread stage must settle its promise, even after a failure, or a worker waiting on it never returns.
+    for (size_t i = 0; i < stages_.size(); ++i) {
+        if (stages_[i].affinity == Affinity::MAIN_THREAD) {
+            execute(i);
+        }
+    }
+    for (auto& worker : workers) {
+        worker.wait();
+    }
+    elapsed_ = std::chrono::steady_clock::now() - begin;
+    for (auto& stage : done) {
+        stage.get();
+    }
+}
+
+void Startup::Report(const std::shared_ptr<spdlog::logger>& logger) const {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    Milliseconds serial{0};
+    for (const auto& timing : timings_) {
+        serial += timing.duration;
+        logger->info("Startup stage {:<12} start {:>8.3f} ms, took {:>8.3f} ms ({})", timing.name, Milliseconds(timing.start).count(), Milliseconds(timing.duration).count(), timing.main_thread ? "main" : "worker");
+    }
+    logger->info("Startup finished in {:.3f} ms, {:.3f} ms of stage work", Milliseconds(elapsed_).count(), serial.count());
+}
+
+const std::vector<StageTiming>& Startup::Timings() const {
+    return timings_;
+}
+
+std::chrono::nanoseconds Startup::Elapsed() const {
+    return elapsed_;
+}
+
+}  // namespace serenity
\ No newline at end of file
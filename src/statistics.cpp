@@ -0,0 +1,128 @@
+/**
+ * @file statistics.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+namespace serenity {
+
+RollingSamples::RollingSamples(size_t capacity) : capacity_(capacity) {
+    if (capacity == 0) {
+        throw std::runtime_error("Rolling sample window must not be empty.");
+    }
+    samples_.reserve(capacity);
+}
+
+void RollingSamples::Add(double sample) {
+    if (samples_.size() < capacity_) {
+        samples_.push_back(sample);
+    } else {
+        samples_[next_] = sample;
+    }
+    next_ = (next_ + 1) % capacity_;
+}
+
+void RollingSamples::Clear() {
+    samples_.clear();
+    next_ = 0;
+}
+
+size_t RollingSamples::Size() const {
+    return samples_.size();
+}
+
+bool RollingSamples::Empty() const {
+    return samples_.empty();
+}
+
+double RollingSamples::Min() const {
+    return samples_.empty() ? 0.0 : *std::min_element(samples_.begin(), samples_.end());
+}
+
+double RollingSamples::Max() const {
+    return samples_.empty() ? 0.0 : *std::max_element(samples_.begin(), samples_.end());
+}
+
+double RollingSamples::Mean() const {
+    return samples_.empty() ? 0.0 : std::accumulate(samples_.begin(), samples_.end(), 0.0) / static_cast<double>(samples_.size());
+}
+
+double RollingSamples::Percentile(double percentile) const {
+    return serenity::Percentile(samples_, percentile);
+}
+
+std::vector<double> RollingSamples::Samples() const {
+    return samples_;
+}
+
+double Percentile(std::vector<double> samples, double percentile) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    // Nearest-rank percentile.
+    const auto rank = static_cast<size_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(samples.size())));
+    const auto index = rank == 0 ? 0 : rank - 1;
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return samples[index];
+}
+
+double Median(std::vector<double> samples) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    const auto middle = samples.size() / 2;
+    return samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+}
+
+double MannWhitneyGreater(const std::vector<double>& baseline, const std::vector<double>& candidate) {
+    if (baseline.empty() || candidate.empty()) {
+        return 1.0;
+    }
+    std::vector<std::pair<double, bool>> pooled;
+    pooled.reserve(baseline.size() + candidate.size());
+    for (auto sample : baseline) {
+        pooled.emplace_back(sample, false);
+    }
+    for (auto sample : candidate) {
+        pooled.emplace_back(sample, true);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    const auto n = static_cast<double>(pooled.size());
+    double candidate_ranks = 0.0;
+    double ties = 0.0;
+    for (size_t begin = 0; begin < pooled.size();) {
+        auto end = begin;
+        while (end < pooled.size() && pooled[end].first == pooled[begin].first) {
+            ++end;
+        }
+        // Tied samples share the average of the ranks they span.
+        const auto rank = (static_cast<double>(begin + end) + 1.0) / 2.0;
+        for (auto i = begin; i < end; ++i) {
+            candidate_ranks += pooled[i].second ? rank : 0.0;
+        }
+        const auto count = static_cast<double>(end - begin);
+        ties += count * count * count - count;
+        begin = end;
+    }
+    const auto n1 = static_cast<double>(baseline.size());
+    const auto n2 = static_cast<double>(candidate.size());
+    const auto u = candidate_ranks - n2 * (n2 + 1.0) / 2.0;
+    const auto variance = n1 * n2 / 12.0 * ((n + 1.0) - ties / (n * (n - 1.0)));
+    if (variance <= 0.0) {
+        return 1.0;
+    }
+    const auto z = (u - n1 * n2 / 2.0 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+}  // namespace serenity
\ No newline at end of file
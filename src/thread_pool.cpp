@@ -0,0 +1,135 @@
+/**
+ * @file thread_pool.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+#include "cpu_profiler.h"
+
+namespace serenity {
+
+ThreadPool::ThreadPool(size_t threads) {
+    threads_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        threads_.emplace_back(&ThreadPool::Work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+size_t ThreadPool::DefaultThreads() {
+    // The thread calling ParallelFor() does its share of the work.
+    const auto hardware = std::thread::hardware_concurrency();
+    return hardware > 1 ? hardware - 1 : 1;
+}
+
+size_t ThreadPool::Size() const {
+    return threads_.size();
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t index)>& task) {
+    if (count == 0) {
+        return;
+    }
+    if (count == 1 || threads_.empty()) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    struct Batch {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> pending{0};
+        std::mutex mutex{};
+        std::exception_ptr error{};
+    };
+    auto batch = std::make_shared<Batch>();
+    auto drain = [batch, count, &task]() {
+        for (auto i = batch->next++; i < count; i = batch->next++) {
+            try {
+                task(i);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(batch->mutex);
+                if (!batch->error) {
+                    batch->error = std::current_exception();
+                }
+                batch->next = count;
+            }
+        }
+    };
+
+    const auto helpers = std::min(threads_.size(), count - 1);
+    batch->pending = helpers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < helpers; ++i) {
+            tasks_.emplace_back([batch, drain]() {
+                drain();
+                --batch->pending;
+            });
+        }
+    }
+    wake_.notify_all();
+    drain();
+    // Helpers still queued exit immediately once they run, but they reference the task, so wait for every one of them.
+    while (batch->pending > 0) {
+        if (!RunOne()) {
+            std::this_thread::yield();
+        }
+    }
+    if (batch->error) {
+        std::rethrow_exception(batch->error);
+    }
+}
+
+bool ThreadPool::RunOne() {
+    std::function<void()> task;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tasks_.empty()) {
+            return false;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+    }
+    task();
+    return true;
+}
+
+void ThreadPool::Work() {
+    SERENITY_ZONE_THREAD_NAME("worker");
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this]() {
+                return stopping_ || !tasks_.empty();
+            });
+            if (stopping_ && tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+}  // namespace serenity
\ No newline at end of file
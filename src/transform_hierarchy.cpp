@@ -0,0 +1,367 @@
+/**
+ * @file transform_hierarchy.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "transform_hierarchy.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "cpu_profiler.h"
+
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#include "simd/matrix.h"
+#endif
+
+namespace serenity {
+
+namespace {
+
+glm::mat4 Compose(const Transform& local) {
+    glm::mat4 matrix = glm::mat4_cast(local.rotation);
+    matrix[0] *= local.scale.x;
+    matrix[1] *= local.scale.y;
+    matrix[2] *= local.scale.z;
+    matrix[3] = glm::vec4(local.position, 1.0F);
+    return matrix;
+}
+
+void Multiply(const glm::mat4& parent, const glm::mat4& local, glm::mat4& world) {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // glm only takes its SIMD path for aligned types; the matrices here are packed, so load the columns unaligned.
+    glm_vec4 lhs[4];
+    glm_vec4 rhs[4];
+    glm_vec4 result[4];
+    for (glm::length_t column = 0; column < 4; ++column) {
+        lhs[column] = _mm_loadu_ps(&parent[column][0]);
+        rhs[column] = _mm_loadu_ps(&local[column][0]);
+    }
+    glm_mat4_mul(lhs, rhs, result);
+    for (glm::length_t column = 0; column < 4; ++column) {
+        _mm_storeu_ps(&world[column][0], result[column]);
+    }
+#else
+    world = parent * local;
+#endif
+}
+
+}  // namespace
+
+NodeId TransformHierarchy::Add(NodeId parent, const Transform& local, bool is_static) {
+    uint32_t parent_index = INVALID_NODE;
+    if (parent != INVALID_NODE) {
+        parent_index = IndexOf(parent);
+    }
+    const auto index = static_cast<uint32_t>(parents_.size());
+    // Appending keeps preorder when the parent's subtree already ends at the back, which is how scenes are usually
+    // built; otherwise the arrays are re-sorted once, on the next Update().
+    if (parent_index != INVALID_NODE && parent_index + subtree_sizes_[parent_index] != index) {
+        unordered_ = true;
+    }
+    if (!unordered_) {
+        for (auto ancestor = parent_index; ancestor != INVALID_NODE; ancestor = parents_[ancestor]) {
+            ++subtree_sizes_[ancestor];
+        }
+    }
+    NodeId node;
+    if (free_ids_.empty()) {
+        node = static_cast<NodeId>(indices_.size());
+        indices_.push_back(index);
+    } else {
+        node = free_ids_.back();
+        free_ids_.pop_back();
+        indices_[node] = index;
+    }
+    parents_.push_back(parent_index);
+    subtree_sizes_.push_back(1);
+    locals_.push_back(local);
+    worlds_.emplace_back(1.0F);
+    static_.push_back(is_static ? 1 : 0);
+    dirty_.push_back(1);
+    ids_.push_back(node);
+    dirty_nodes_.push_back(node);
+    return node;
+}
+
+void TransformHierarchy::Remove(NodeId node) {
+    if (unordered_) {
+        Reorder();
+    }
+    // Indices shift and the removed ids must read as identity again, so states older than the next Update() are copied
+    // in full.
+    layout_generation_ = generation_ + 1;
+    const auto begin = IndexOf(node);
+    const auto count = subtree_sizes_[begin];
+    const auto end = begin + count;
+    for (auto ancestor = parents_[begin]; ancestor != INVALID_NODE; ancestor = parents_[ancestor]) {
+        subtree_sizes_[ancestor] -= count;
+    }
+    for (auto i = begin; i < end; ++i) {
+        indices_[ids_[i]] = INVALID_NODE;
+        free_ids_.push_back(ids_[i]);
+    }
+    auto erase = [begin, end](auto& values) {
+        values.erase(values.begin() + begin, values.begin() + end);
+    };
+    erase(parents_);
+    erase(subtree_sizes_);
+    erase(locals_);
+    erase(worlds_);
+    erase(static_);
+    erase(dirty_);
+    erase(ids_);
+    for (auto i = begin; i < parents_.size(); ++i) {
+        if (parents_[i] != INVALID_NODE && parents_[i] >= end) {
+            parents_[i] -= count;
+        }
+        indices_[ids_[i]] = i;
+    }
+}
+
+void TransformHierarchy::SetLocal(NodeId node, const Transform& local) {
+    const auto index = IndexOf(node);
+    if (static_[index]) {
+        throw std::runtime_error("Cannot move a static transform node.");
+    }
+    locals_[index] = local;
+    if (!dirty_[index]) {
+        dirty_[index] = 1;
+        dirty_nodes_.push_back(node);
+    }
+}
+
+void TransformHierarchy::SetStatic(NodeId node, bool is_static) {
+    static_[IndexOf(node)] = is_static ? 1 : 0;
+}
+
+bool TransformHierarchy::Alive(NodeId node) const {
+    return node < indices_.size() && indices_[node] != INVALID_NODE;
+}
+
+bool TransformHierarchy::IsStatic(NodeId node) const {
+    return static_[IndexOf(node)] != 0;
+}
+
+NodeId TransformHierarchy::Parent(NodeId node) const {
+    const auto parent = parents_[IndexOf(node)];
+    return parent == INVALID_NODE ? INVALID_NODE : ids_[parent];
+}
+
+const Transform& TransformHierarchy::Local(NodeId node) const {
+    return locals_[IndexOf(node)];
+}
+
+const glm::mat4& TransformHierarchy::World(NodeId node) const {
+    return worlds_[IndexOf(node)];
+}
+
+void TransformHierarchy::CopyWorlds(std::vector<glm::mat4>& worlds, uint64_t since) const {
+    SERENITY_ZONE_FUNCTION();
+    const auto replayable = !history_.empty() && history_.front().generation <= since + 1;
+    if (since == 0 || since < layout_generation_ || !replayable || worlds.size() > indices_.size()) {
+        worlds.assign(indices_.size(), glm::mat4(1.0F));
+        for (size_t i = 0; i < ids_.size(); ++i) {
+            worlds[ids_[i]] = worlds_[i];
+        }
+        return;
+    }
+    // Ids added since were appended, and their nodes are in the swept ranges.
+    worlds.resize(indices_.size(), glm::mat4(1.0F));
+    for (const auto& sweeps : history_) {
+        if (sweeps.generation <= since) {
+            continue;
+        }
+        for (const auto& range : sweeps.ranges) {
+            for (auto i = range.begin; i < range.end; ++i) {
+                worlds[ids_[i]] = worlds_[i];
+            }
+        }
+    }
+}
+
+size_t TransformHierarchy::Size() const {
+    return parents_.size();
+}
+
+void TransformHierarchy::Update(ThreadPool& pool) {
+    SERENITY_ZONE_FUNCTION();
+    ++generation_;
+    if (unordered_) {
+        Reorder();
+        layout_generation_ = generation_;
+    }
+    std::vector<uint32_t> roots;
+    roots.reserve(dirty_nodes_.size());
+    for (auto node : dirty_nodes_) {
+        if (!Alive(node)) {
+            continue;
+        }
+        const auto index = indices_[node];
+        if (dirty_[index]) {
+            dirty_[index] = 0;
+            roots.push_back(index);
+        }
+    }
+    dirty_nodes_.clear();
+    std::sort(roots.begin(), roots.end());
+
+    // A dirty node inside an earlier dirty subtree is covered by that subtree's sweep.
+    std::vector<Range> subtrees;
+    for (auto root : roots) {
+        if (!subtrees.empty() && root < subtrees.back().end) {
+            continue;
+        }
+        subtrees.push_back({root, root + subtree_sizes_[root]});
+    }
+
+    // Split large subtrees: sweep the root here, then treat each child subtree as independent work. Walking the stack
+    // in preorder keeps the ranges sorted.
+    std::vector<Range> ranges;
+    std::vector<Range> stack(subtrees.rbegin(), subtrees.rend());
+    Sweeps sweeps{generation_, {}};
+    updated_ = 0;
+    while (!stack.empty()) {
+        const auto range = stack.back();
+        stack.pop_back();
+        if (range.end - range.begin <= SPLIT_NODES) {
+            ranges.push_back(range);
+            updated_ += range.end - range.begin;
+            continue;
+        }
+        Sweep(range.begin, range.begin + 1);
+        sweeps.ranges.push_back({range.begin, range.begin + 1});
+        ++updated_;
+        const auto first = stack.size();
+        for (auto child = range.begin + 1; child < range.end; child += subtree_sizes_[child]) {
+            stack.push_back({child, child + subtree_sizes_[child]});
+        }
+        std::reverse(stack.begin() + static_cast<std::ptrdiff_t>(first), stack.end());
+    }
+
+    // Batch neighbouring small ranges so a frame with thousands of moved leaves is not thousands of tasks.
+    std::vector<Range> batches;
+    size_t batch_nodes = 0;
+    for (uint32_t i = 0; i < ranges.size(); ++i) {
+        if (batches.empty() || batch_nodes >= SPLIT_NODES) {
+            batches.push_back({i, i});
+            batch_nodes = 0;
+        }
+        batches.back().end = i + 1;
+        batch_nodes += ranges[i].end - ranges[i].begin;
+    }
+    pool.ParallelFor(batches.size(), [this, &ranges, &batches](size_t batch) {
+        for (auto i = batches[batch].begin; i < batches[batch].end; ++i) {
+            Sweep(ranges[i].begin, ranges[i].end);
+        }
+    });
+    sweeps.ranges.insert(sweeps.ranges.end(), ranges.begin(), ranges.end());
+    history_.push_back(std::move(sweeps));
+    if (history_.size() > HISTORY) {
+        history_.pop_front();
+    }
+}
+
+uint64_t TransformHierarchy::Generation() const {
+    return generation_;
+}
+
+size_t TransformHierarchy::Updated() const {
+    return updated_;
+}
+
+uint32_t TransformHierarchy::IndexOf(NodeId node) const {
+    if (!Alive(node)) {
+        throw std::runtime_error("Unknown transform node " + std::to_string(node) + ".");
+    }
+    return indices_[node];
+}
+
+void TransformHierarchy::Reorder() {
+    SERENITY_ZONE_FUNCTION();
+    const auto count = static_cast<uint32_t>(parents_.size());
+    // Children of each node in their current relative order, as offsets into one array.
+    std::vector<uint32_t> child_offsets(count + 1, 0);
+    for (auto parent : parents_) {
+        if (parent != INVALID_NODE) {
+            ++child_offsets[parent + 1];
+        }
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+        child_offsets[i + 1] += child_offsets[i];
+    }
+    std::vector<uint32_t> children(child_offsets[count]);
+    std::vector<uint32_t> cursor(child_offsets.begin(), child_offsets.end() - 1);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (parents_[i] != INVALID_NODE) {
+            children[cursor[parents_[i]]++] = i;
+        }
+    }
+
+    std::vector<uint32_t> order;
+    order.reserve(count);
+    std::vector<uint32_t> stack;
+    for (uint32_t root = count; root-- > 0;) {
+        if (parents_[root] == INVALID_NODE) {
+            stack.push_back(root);
+        }
+    }
+    while (!stack.empty()) {
+        const auto index = stack.back();
+        stack.pop_back();
+        order.push_back(index);
+        for (auto child = child_offsets[index + 1]; child-- > child_offsets[index];) {
+            stack.push_back(children[child]);
+        }
+    }
+
+    std::vector<uint32_t> remap(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        remap[order[i]] = i;
+    }
+    auto permute = [&order](auto& values) {
+        std::remove_reference_t<decltype(values)> sorted;
+        sorted.reserve(values.size());
+        for (auto index : order) {
+            sorted.push_back(values[index]);
+        }
+        values.swap(sorted);
+    };
+    permute(parents_);
+    permute(locals_);
+    permute(worlds_);
+    permute(static_);
+    permute(dirty_);
+    permute(ids_);
+    for (uint32_t i = 0; i < count; ++i) {
+        if (parents_[i] != INVALID_NODE) {
+            parents_[i] = remap[parents_[i]];
+        }
+        indices_[ids_[i]] = i;
+    }
+    subtree_sizes_.assign(count, 1);
+    for (auto i = count; i-- > 0;) {
+        if (parents_[i] != INVALID_NODE) {
+            subtree_sizes_[parents_[i]] += subtree_sizes_[i];
+        }
+    }
+    unordered_ = false;
+}
+
+void TransformHierarchy::Sweep(uint32_t begin, uint32_t end) {
+    // Preorder puts every parent before its children, so one forward pass sees each parent already updated.
+    for (auto i = begin; i < end; ++i) {
+        const auto local = Compose(locals_[i]);
+        if (parents_[i] == INVALID_NODE) {
+            worlds_[i] = local;
+        } else {
+            Multiply(worlds_[parents_[i]], local, worlds_[i]);
+        }
+    }
+}
+
+}  // namespace serenity
\ No newline at end of file
@@ -0,0 +1,458 @@
+/**
+ * @file vertex_format.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include "vertex_format.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include "cpu_profiler.h"
+#include "gtc/packing.hpp"
+
+namespace serenity {
+
+namespace {
+
+constexpr float SNORM16_MAX = 32767.0F;
+
+uint32_t PositionSize(PositionFormat format) {
+    return format == PositionFormat::FLOAT32 ? 12 : 8;
+}
+
+uint32_t NormalSize(NormalFormat format) {
+    return format == NormalFormat::FLOAT32 ? 12 : 4;
+}
+
+uint32_t TangentSize(NormalFormat format) {
+    return format == NormalFormat::FLOAT32 ? 16 : 4;
+}
+
+uint32_t UvSize(UvFormat format) {
+    return format == UvFormat::FLOAT32 ? 8 : 4;
+}
+
+template <typename T, size_t N>
+void Store(uint8_t* out, const T (&values)[N]) {
+    std::memcpy(out, values, sizeof(values));
+}
+
+template <typename T, size_t N>
+void Load(const uint8_t* in, T (&values)[N]) {
+    std::memcpy(values, in, sizeof(values));
+}
+
+glm::vec2 SignNotZero(const glm::vec2& v) {
+    return {v.x >= 0.0F ? 1.0F : -1.0F, v.y >= 0.0F ? 1.0F : -1.0F};
+}
+
+// Angle between two directions in degrees; atan2 stays accurate for the tiny angles quantization produces.
+float AngleDegrees(const glm::vec3& a, const glm::vec3& b) {
+    return glm::degrees(std::atan2(glm::length(glm::cross(a, b)), glm::dot(a, b)));
+}
+
+void FitPositions(const Mesh& mesh, PositionFormat format, Dequantization& dequantization) {
+    dequantization.position_offset = glm::vec3(0.0F);
+    dequantization.position_scale = glm::vec3(1.0F);
+    const auto box = mesh.Bounds();
+    if (format == PositionFormat::FLOAT32 || box.Empty()) {
+        return;
+    }
+    dequantization.position_offset = box.Center();
+    if (format == PositionFormat::SNORM16) {
+        const auto half_extent = (box.max - box.min) * 0.5F;
+        dequantization.position_scale = glm::mix(half_extent, glm::vec3(1.0F), glm::equal(half_extent, glm::vec3(0.0F)));
+    }
+}
+
+void FitUvs(const Mesh& mesh, UvFormat format, Dequantization& dequantization) {
+    dequantization.uv_offset = glm::vec2(0.0F);
+    dequantization.uv_scale = glm::vec2(1.0F);
+    if (format != UvFormat::UNORM16 || mesh.uvs.empty()) {
+        return;
+    }
+    glm::vec2 min(std::numeric_limits<float>::max());
+    glm::vec2 max(std::numeric_limits<float>::lowest());
+    for (const auto& uv : mesh.uvs) {
+        min = glm::min(min, uv);
+        max = glm::max(max, uv);
+    }
+    const auto range = max - min;
+    dequantization.uv_offset = min;
+    dequantization.uv_scale = glm::mix(range, glm::vec2(1.0F), glm::equal(range, glm::vec2(0.0F)));
+}
+
+void EncodePosition(PositionFormat format, const Dequantization& dequantization, const glm::vec3& position, uint8_t* out) {
+    const auto local = (position - dequantization.position_offset) / dequantization.position_scale;
+    switch (format) {
+        case PositionFormat::FLOAT32:
+            Store(out, {local.x, local.y, local.z});
+            break;
+        case PositionFormat::HALF:
+            Store(out, {glm::packHalf1x16(local.x), glm::packHalf1x16(local.y), glm::packHalf1x16(local.z), uint16_t{0}});
+            break;
+        case PositionFormat::SNORM16:
+            Store(out, {glm::packSnorm1x16(local.x), glm::packSnorm1x16(local.y), glm::packSnorm1x16(local.z), uint16_t{0}});
+            break;
+    }
+}
+
+glm::vec3 DecodePosition(PositionFormat format, const Dequantization& dequantization, const uint8_t* in) {
+    glm::vec3 local(0.0F);
+    if (format == PositionFormat::FLOAT32) {
+        float values[3];
+        Load(in, values);
+        local = {values[0], values[1], values[2]};
+    } else {
+        uint16_t values[3];
+        Load(in, values);
+        auto unpack = format == PositionFormat::HALF ? glm::unpackHalf1x16 : glm::unpackSnorm1x16;
+        local = {unpack(values[0]), unpack(values[1]), unpack(values[2])};
+    }
+    return dequantization.position_offset + dequantization.position_scale * local;
+}
+
+void EncodeNormal(NormalFormat format, const glm::vec3& normal, uint8_t* out) {
+    if (format == NormalFormat::FLOAT32) {
+        Store(out, {normal.x, normal.y, normal.z});
+        return;
+    }
+    const auto code = OctahedralEncode(normal);
+    Store(out, {code.x, code.y});
+}
+
+glm::vec3 DecodeNormal(NormalFormat format, const uint8_t* in) {
+    if (format == NormalFormat::FLOAT32) {
+        float values[3];
+        Load(in, values);
+        return {values[0], values[1], values[2]};
+    }
+    int16_t values[2];
+    Load(in, values);
+    return OctahedralDecode({values[0], values[1]});
+}
+
+void EncodeTangent(NormalFormat format, const glm::vec4& tangent, uint8_t* out) {
+    if (format == NormalFormat::FLOAT32) {
+        Store(out, {tangent.x, tangent.y, tangent.z, tangent.w < 0.0F ? -1.0F : 1.0F});
+        return;
+    }
+    auto code = OctahedralEncode(glm::vec3(tangent));
+    // The low bit of y costs a 32767th of the octahedron and saves a component; the shader reads it back with
+    // int(round(y * 32767.0)) & 1. Clearing the bit of -32767 would give -32768, which the SNORM fetch clamps back to
+    // -32767 and so reads as set, hence y stays at -32766 or above.
+    const auto y = std::max(code.y, static_cast<int16_t>(-32766));
+    code.y = static_cast<int16_t>((y & ~1) | (tangent.w < 0.0F ? 1 : 0));
+    Store(out, {code.x, code.y});
+}
+
+glm::vec4 DecodeTangent(NormalFormat format, const uint8_t* in) {
+    if (format == NormalFormat::FLOAT32) {
+        float values[4];
+        Load(in, values);
+        return {values[0], values[1], values[2], values[3]};
+    }
+    int16_t values[2];
+    Load(in, values);
+    // The sign bit as the shader sees it, after the SNORM fetch.
+    const auto sign = static_cast<int>(std::round(std::max(static_cast<float>(values[1]) / SNORM16_MAX, -1.0F) * SNORM16_MAX)) & 1;
+    return {OctahedralDecode({values[0], values[1]}), sign != 0 ? -1.0F : 1.0F};
+}
+
+void EncodeUv(UvFormat format, const Dequantization& dequantization, const glm::vec2& uv, uint8_t* out) {
+    switch (format) {
+        case UvFormat::FLOAT32:
+            Store(out, {uv.x, uv.y});
+            break;
+        case UvFormat::HALF:
+            Store(out, {glm::packHalf1x16(uv.x), glm::packHalf1x16(uv.y)});
+            break;
+        case UvFormat::UNORM16: {
+            const auto local = (uv - dequantization.uv_offset) / dequantization.uv_scale;
+            Store(out, {glm::packUnorm1x16(local.x), glm::packUnorm1x16(local.y)});
+            break;
+        }
+    }
+}
+
+glm::vec2 DecodeUv(UvFormat format, const Dequantization& dequantization, const uint8_t* in) {
+    if (format == UvFormat::FLOAT32) {
+        float values[2];
+        Load(in, values);
+        return {values[0], values[1]};
+    }
+    uint16_t values[2];
+    Load(in, values);
+    if (format == UvFormat::HALF) {
+        return {glm::unpackHalf1x16(values[0]), glm::unpackHalf1x16(values[1])};
+    }
+    return dequantization.uv_offset + dequantization.uv_scale * glm::vec2(glm::unpackUnorm1x16(values[0]), glm::unpackUnorm1x16(values[1]));
+}
+
+float TangentError(const glm::vec4& tangent, const glm::vec4& decoded) {
+    if ((tangent.w < 0.0F) != (decoded.w < 0.0F)) {
+        return 180.0F;
+    }
+    return AngleDegrees(glm::vec3(tangent), glm::vec3(decoded));
+}
+
+float PositionError(const Mesh& mesh, PositionFormat format) {
+    Dequantization dequantization;
+    FitPositions(mesh, format, dequantization);
+    uint8_t scratch[16];
+    float error = 0.0F;
+    for (const auto& position : mesh.positions) {
+        EncodePosition(format, dequantization, position, scratch);
+        const auto decoded = DecodePosition(format, dequantization, scratch);
+        // Written so a NaN from an overflowing half rejects the format.
+        error = glm::distance(position, decoded) <= error ? error : glm::distance(position, decoded);
+    }
+    return error;
+}
+
+float NormalError(const Mesh& mesh, NormalFormat format) {
+    uint8_t scratch[16];
+    float error = 0.0F;
+    for (const auto& normal : mesh.normals) {
+        EncodeNormal(format, normal, scratch);
+        error = std::max(error, AngleDegrees(normal, DecodeNormal(format, scratch)));
+    }
+    for (const auto& tangent : mesh.tangents) {
+        EncodeTangent(format, tangent, scratch);
+        error = std::max(error, TangentError(tangent, DecodeTangent(format, scratch)));
+    }
+    return error;
+}
+
+float UvError(const Mesh& mesh, UvFormat format) {
+    Dequantization dequantization;
+    FitUvs(mesh, format, dequantization);
+    uint8_t scratch[16];
+    float error = 0.0F;
+    for (const auto& uv : mesh.uvs) {
+        EncodeUv(format, dequantization, uv, scratch);
+        const auto difference = glm::abs(uv - DecodeUv(format, dequantization, scratch));
+        const auto component = std::max(difference.x, difference.y);
+        error = component <= error ? error : component;
+    }
+    return error;
+}
+
+// Among same-sized candidates, the lowest error within the bound; FLOAT32 when none qualifies.
+template <typename Format, typename Error>
+Format Pick(std::initializer_list<Format> candidates, float bound, Error&& error) {
+    auto best = Format::FLOAT32;
+    auto best_error = std::numeric_limits<float>::infinity();
+    for (auto candidate : candidates) {
+        const auto candidate_error = error(candidate);
+        if (candidate_error <= bound && candidate_error < best_error) {
+            best = candidate;
+            best_error = candidate_error;
+        }
+    }
+    return best;
+}
+
+VkFormat PositionVkFormat(PositionFormat format) {
+    switch (format) {
+        case PositionFormat::HALF:
+            return VK_FORMAT_R16G16B16A16_SFLOAT;
+        case PositionFormat::SNORM16:
+            return VK_FORMAT_R16G16B16A16_SNORM;
+        default:
+            return VK_FORMAT_R32G32B32_SFLOAT;
+    }
+}
+
+VkFormat UvVkFormat(UvFormat format) {
+    switch (format) {
+        case UvFormat::HALF:
+            return VK_FORMAT_R16G16_SFLOAT;
+        case UvFormat::UNORM16:
+            return VK_FORMAT_R16G16_UNORM;
+        default:
+            return VK_FORMAT_R32G32_SFLOAT;
+    }
+}
+
+}  // namespace
+
+uint32_t VertexFormat::PositionStride() const {
+    return PositionSize(position);
+}
+
+uint32_t VertexFormat::AttributeStride() const {
+    return UvOffset() + (uvs ? UvSize(uv) : 0);
+}
+
+uint32_t VertexFormat::NormalOffset() const {
+    return 0;
+}
+
+uint32_t VertexFormat::TangentOffset() const {
+    return NormalSize(normal);
+}
+
+uint32_t VertexFormat::UvOffset() const {
+    return TangentOffset() + (tangents ? TangentSize(normal) : 0);
+}
+
+VertexFormat ChooseVertexFormat(const Mesh& mesh, const QuantizationBounds& bounds) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    VertexFormat format;
+    format.tangents = !mesh.tangents.empty();
+    format.uvs = !mesh.uvs.empty();
+    format.position = Pick({PositionFormat::HALF, PositionFormat::SNORM16}, bounds.position_error, [&mesh](PositionFormat candidate) {
+        return PositionError(mesh, candidate);
+    });
+    format.normal = Pick({NormalFormat::OCTAHEDRAL16}, bounds.normal_error, [&mesh](NormalFormat candidate) {
+        return NormalError(mesh, candidate);
+    });
+    if (format.uvs) {
+        format.uv = Pick({UvFormat::HALF, UvFormat::UNORM16}, bounds.uv_error, [&mesh](UvFormat candidate) {
+            return UvError(mesh, candidate);
+        });
+    }
+    return format;
+}
+
+QuantizedMesh Quantize(const Mesh& mesh, const VertexFormat& format) {
+    SERENITY_ZONE_FUNCTION();
+    mesh.Validate();
+    if ((format.tangents && mesh.tangents.empty()) || (format.uvs && mesh.uvs.empty())) {
+        throw std::runtime_error("Vertex format asks for attributes the mesh does not have.");
+    }
+    QuantizedMesh result;
+    result.format = format;
+    FitPositions(mesh, format.position, result.dequantization);
+    FitUvs(mesh, format.uv, result.dequantization);
+
+    const auto vertices = mesh.VertexCount();
+    const auto position_stride = format.PositionStride();
+    const auto attribute_stride = format.AttributeStride();
+    result.positions.resize(vertices * position_stride);
+    result.attributes.resize(vertices * attribute_stride);
+    auto& report = result.report;
+    for (size_t i = 0; i < vertices; ++i) {
+        auto* position = result.positions.data() + i * position_stride;
+        EncodePosition(format.position, result.dequantization, mesh.positions[i], position);
+        const auto decoded = DecodePosition(format.position, result.dequantization, position);
+        report.position_error = std::max(report.position_error, glm::distance(mesh.positions[i], decoded));
+
+        auto* attributes = result.attributes.data() + i * attribute_stride;
+        EncodeNormal(format.normal, mesh.normals[i], attributes + format.NormalOffset());
+        report.normal_error = std::max(report.normal_error, AngleDegrees(mesh.normals[i], DecodeNormal(format.normal, attributes + format.NormalOffset())));
+        if (format.tangents) {
+            EncodeTangent(format.normal, mesh.tangents[i], attributes + format.TangentOffset());
+            report.tangent_error = std::max(report.tangent_error, TangentError(mesh.tangents[i], DecodeTangent(format.normal, attributes + format.TangentOffset())));
+        }
+        if (format.uvs) {
+            EncodeUv(format.uv, result.dequantization, mesh.uvs[i], attributes + format.UvOffset());
+            const auto difference = glm::abs(mesh.uvs[i] - DecodeUv(format.uv, result.dequantization, attributes + format.UvOffset()));
+            report.uv_error = std::max({report.uv_error, difference.x, difference.y});
+        }
+    }
+    result.indices = mesh.indices;
+
+    const auto float_stride = 12 + 12 + (format.tangents ? 16 : 0) + (format.uvs ? 8 : 0);
+    report.vertices = vertices;
+    report.float_bytes = vertices * float_stride;
+    report.position_bytes = result.positions.size();
+    report.attribute_bytes = result.attributes.size();
+    return result;
+}
+
+QuantizedMesh Quantize(const Mesh& mesh, const QuantizationBounds& bounds) {
+    return Quantize(mesh, ChooseVertexFormat(mesh, bounds));
+}
+
+Mesh Dequantize(const QuantizedMesh& mesh) {
+    const auto& format = mesh.format;
+    const auto vertices = mesh.report.vertices;
+    if (mesh.positions.size() != vertices * format.PositionStride() || mesh.attributes.size() != vertices * format.AttributeStride()) {
+        throw std::runtime_error("Quantized mesh streams do not match its vertex format.");
+    }
+    Mesh result;
+    result.positions.reserve(vertices);
+    result.normals.reserve(vertices);
+    for (size_t i = 0; i < vertices; ++i) {
+        result.positions.push_back(DecodePosition(format.position, mesh.dequantization, mesh.positions.data() + i * format.PositionStride()));
+        const auto* attributes = mesh.attributes.data() + i * format.AttributeStride();
+        result.normals.push_back(DecodeNormal(format.normal, attributes + format.NormalOffset()));
+        if (format.tangents) {
+            result.tangents.push_back(DecodeTangent(format.normal, attributes + format.TangentOffset()));
+        }
+        if (format.uvs) {
+            result.uvs.push_back(DecodeUv(format.uv, mesh.dequantization, attributes + format.UvOffset()));
+        }
+    }
+    result.indices = mesh.indices;
+    return result;
+}
+
+VertexInputLayout DescribeVertexInput(const VertexFormat& format, bool depth_only) {
+    VertexInputLayout layout;
+    layout.bindings.push_back({0, format.PositionStride(), VK_VERTEX_INPUT_RATE_VERTEX});
+    layout.attributes.push_back({0, 0, PositionVkFormat(format.position), 0});
+    if (depth_only) {
+        return layout;
+    }
+    const auto octahedral = format.normal == NormalFormat::OCTAHEDRAL16;
+    layout.bindings.push_back({1, format.AttributeStride(), VK_VERTEX_INPUT_RATE_VERTEX});
+    layout.attributes.push_back({1, 1, octahedral ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R32G32B32_SFLOAT, format.NormalOffset()});
+    if (format.tangents) {
+        layout.attributes.push_back({2, 1, octahedral ? VK_FORMAT_R16G16_SNORM : VK_FORMAT_R32G32B32A32_SFLOAT, format.TangentOffset()});
+    }
+    if (format.uvs) {
+        layout.attributes.push_back({3, 1, UvVkFormat(format.uv), format.UvOffset()});
+    }
+    return layout;
+}
+
+glm::i16vec2 OctahedralEncode(const glm::vec3& direction) {
+    const auto sum = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+    if (sum == 0.0F) {
+        return {0, 0};
+    }
+    glm::vec2 projected = glm::vec2(direction) / sum;
+    if (direction.z < 0.0F) {
+        projected = (1.0F - glm::abs(glm::vec2(projected.y, projected.x))) * SignNotZero(projected);
+    }
+    // Rounding each coordinate on its own can land on the wrong side of the fold; try the four neighbours.
+    const auto base = glm::floor(glm::clamp(projected, -1.0F, 1.0F) * SNORM16_MAX);
+    const auto target = direction / glm::length(direction);
+    glm::i16vec2 best(0, 0);
+    auto best_dot = -2.0F;
+    for (int dy = 0; dy <= 1; ++dy) {
+        for (int dx = 0; dx <= 1; ++dx) {
+            const auto candidate = glm::clamp(base + glm::vec2(dx, dy), -SNORM16_MAX, SNORM16_MAX);
+            const glm::i16vec2 code(static_cast<int16_t>(candidate.x), static_cast<int16_t>(candidate.y));
+            const auto dot = glm::dot(OctahedralDecode(code), target);
+            if (dot > best_dot) {
+                best = code;
+                best_dot = dot;
+            }
+        }
+    }
+    return best;
+}
+
+glm::vec3 OctahedralDecode(const glm::i16vec2& code) {
+    // Matches SNORM fetch: -32768 and -32767 both decode to -1.
+    const auto encoded = glm::max(glm::vec2(code) / SNORM16_MAX, glm::vec2(-1.0F));
+    glm::vec3 direction(encoded.x, encoded.y, 1.0F - std::abs(encoded.x) - std::abs(encoded.y));
+    if (direction.z < 0.0F) {
+        const auto folded = (1.0F - glm::abs(glm::vec2(direction.y, direction.x))) * SignNotZero(glm::vec2(direction));
+        direction.x = folded.x;
+        direction.y = folded.y;
+    }
+    return glm::normalize(direction);
+}
+
+}  // namespace serenity
\ No newline at end of file
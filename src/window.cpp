@@ -6,13 +6,19 @@
 
 #include "window.h"
 
+#include "cpu_profiler.h"
+
 namespace serenity {
 
 Window::Window(const std::string& title, int width, int height, const std::shared_ptr<spdlog::logger>& logger) : width_(width), height_(height), title_(title), logger_(logger) {
-    glfwInit();
     window_ = glfwCreateWindow(width, height, title.c_str(), nullptr, nullptr);
     glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
     // glfwWindowHint(GLFW_RESIZABLE, GLFW_FALSE);
+    glfwSetWindowUserPointer(window_, this);
+    glfwSetKeyCallback(window_, KeyCallback);
+    glfwSetMouseButtonCallback(window_, MouseButtonCallback);
+    glfwSetCursorPosCallback(window_, CursorPosCallback);
+    glfwSetScrollCallback(window_, ScrollCallback);
 }
 
 Window::~Window() {
@@ -24,4 +30,70 @@ bool Window::ShouleClose() const {
     return glfwWindowShouldClose(window_);
 }
 
+bool Window::IsMinimized() const {
+    int width = 0;
+    int height = 0;
+    glfwGetFramebufferSize(window_, &width, &height);
+    return glfwGetWindowAttrib(window_, GLFW_ICONIFIED) == GLFW_TRUE || width == 0 || height == 0;
+}
+
+bool Window::IsVisible() const {
+    return glfwGetWindowAttrib(window_, GLFW_VISIBLE) == GLFW_TRUE;
+}
+
+void Window::PollEvents() const {
+    SERENITY_ZONE("Window::PollEvents");
+    glfwPollEvents();
+}
+
+void Window::WaitEvents(double timeout) const {
+    SERENITY_ZONE("Window::WaitEvents");
+    glfwWaitEventsTimeout(timeout);
+}
+
+void Window::Wake() const {
+    glfwPostEmptyEvent();
+}
+
+void Window::SetTitle(const std::string& title) {
+    title_ = title;
+    glfwSetWindowTitle(window_, title_.c_str());
+}
+
+void Window::SetSize(int width, int height) {
+    width_ = width;
+    height_ = height;
+    glfwSetWindowSize(window_, width_, height_);
+}
+
+std::optional<std::chrono::steady_clock::time_point> Window::ConsumeInputTime() {
+    auto input_time = input_time_;
+    input_time_.reset();
+    return input_time;
+}
+
+void Window::KeyCallback(GLFWwindow* window, int /*key*/, int /*scancode*/, int /*action*/, int /*mods*/) {
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->MarkInput();
+}
+
+void Window::MouseButtonCallback(GLFWwindow* window, int /*button*/, int /*action*/, int /*mods*/) {
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->MarkInput();
+}
+
+void Window::CursorPosCallback(GLFWwindow* window, double /*x*/, double /*y*/) {
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->MarkInput();
+}
+
+void Window::ScrollCallback(GLFWwindow* window, double /*x*/, double /*y*/) {
+    static_cast<Window*>(glfwGetWindowUserPointer(window))->MarkInput();
+}
+
+void Window::MarkInput() {
+    SERENITY_ZONE_FUNCTION();
+    // Latency is measured from the oldest input the next frame consumes.
+    if (!input_time_.has_value()) {
+        input_time_ = std::chrono::steady_clock::now();
+    }
+}
+
 }  // namespace serenity
\ No newline at end of file
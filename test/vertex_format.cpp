@@ -0,0 +1,40 @@
+/**
+ * @file vertex_format.cpp
+ * @author liuyulvv (liuyulvv@outlook.com)
+ * @date 2026-10-19
+ */
+
+#include <cmath>
+#include <iostream>
+
+#include "glm.hpp"
+#include "mesh.h"
+#include "vertex_format.h"
+
+// Round-trips sphere tangents through octahedral encoding, including the ones at the -y pole of the octahedron whose
+// code sits at the SNORM minimum, and checks the bitangent sign survives as the shader reads it.
+int main() {
+    auto mesh = serenity::Mesh::Sphere(16, 32, 1.0F);
+    mesh.tangents[0] = glm::vec4(0.0F, -1.0F, 0.0F, 1.0F);
+    mesh.tangents[1] = glm::vec4(0.0F, -1.0F, 0.0F, -1.0F);
+    for (size_t i = 2; i < mesh.tangents.size(); i += 2) {
+        mesh.tangents[i].w = -mesh.tangents[i].w;
+    }
+
+    serenity::VertexFormat format;
+    format.normal = serenity::NormalFormat::OCTAHEDRAL16;
+    format.tangents = true;
+    const auto decoded = serenity::Dequantize(serenity::Quantize(mesh, format));
+
+    int failures = 0;
+    for (size_t i = 0; i < mesh.tangents.size(); ++i) {
+        const auto& expected = mesh.tangents[i];
+        const auto& actual = decoded.tangents[i];
+        const auto cosine = glm::dot(glm::normalize(glm::vec3(expected)), glm::normalize(glm::vec3(actual)));
+        if (actual.w != (expected.w < 0.0F ? -1.0F : 1.0F) || cosine < std::cos(glm::radians(0.25F))) {
+            std::cerr << "tangent " << i << " (" << expected.x << ", " << expected.y << ", " << expected.z << ", " << expected.w << ") decoded as (" << actual.x << ", " << actual.y << ", " << actual.z << ", " << actual.w << ")" << std::endl;
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
\ No newline at end of file